@@ -0,0 +1,211 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+    Offline renderer: applies a saved plugin state (the getStateInformation
+    blob) to many WAV/AIFF files in parallel. Build as a console application
+    linked with the plugin's Shared Code (PluginProcessor.cpp, PluginEditor.cpp)
+    and the juce_audio_formats / juce_audio_processors / juce_dsp modules.
+
+    PJKBatchRenderer --state <state file> --out <directory>
+                     [--block <samples>] [--threads <count>] [--compensate-latency]
+                     <files or directories>...
+
+    By default the output is the raw plugin output, sample for sample with the
+    input (delayed by the plugin latency in oversampling / linear phase mode).
+    With --compensate-latency the first getLatencySamples() output samples are
+    dropped and getTailSamples() zeros are processed after the input, so the
+    output lines up with the input and keeps the filter tail.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+
+//przetwarzanie jednego pliku jako zadanie w puli wtkw
+class RenderJob : public juce::ThreadPoolJob
+{
+public:
+    RenderJob(const juce::File& inputFile, const juce::File& outputFile, const juce::MemoryBlock& stateBlob, int samplesPerBlock,
+              bool shouldCompensateLatency)
+        : juce::ThreadPoolJob(inputFile.getFileName()),
+        input(inputFile), output(outputFile), state(stateBlob), blockSize(samplesPerBlock),
+        compensateLatency(shouldCompensateLatency)
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(input));
+        if (reader == nullptr)
+            return fail("cannot read input file");
+
+        auto* format = formats.findFormatForFileExtension(output.getFileExtension());
+        if (format == nullptr)
+            return fail("unsupported output format");
+
+        const auto numChannels = (int) reader->numChannels;
+
+        //procesor ustawiony tak jak w hocie, tylko w trybie offline
+        PJKParametricEQAudioProcessor processor;
+        processor.setStateInformation(state.getData(), (int) state.getSize());
+
+        //tylko gwna szyna, sidechain zostaje wyczony
+        auto layout = processor.getBusesLayout();
+        layout.inputBuses.getReference(0) = juce::AudioChannelSet::canonicalChannelSet(numChannels);
+        layout.outputBuses.getReference(0) = juce::AudioChannelSet::canonicalChannelSet(numChannels);
+        if (!processor.setBusesLayout(layout))
+            return fail("unsupported channel count " + juce::String(numChannels));
+
+        processor.setNonRealtime(true);
+        processor.prepareToPlay(reader->sampleRate, blockSize);
+
+        output.deleteFile();
+        std::unique_ptr<juce::OutputStream> stream(output.createOutputStream());
+        if (stream == nullptr)
+            return fail("cannot create output file");
+
+        std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(stream.get(), reader->sampleRate,
+            (unsigned int) numChannels, (int) reader->bitsPerSample, reader->metadataValues, 0));
+        if (writer == nullptr)
+            return fail("cannot create writer");
+        stream.release(); //strumie naley teraz do writera
+
+        //staa pami: jeden bufor o rozmiarze bloku, plik czytany kawakami
+        juce::AudioBuffer<float> buffer(numChannels, blockSize);
+        juce::MidiBuffer midi;
+
+        //kompensacja: po pliku id zera na ogon, a pierwsze latency prbek wyjcia jest pomijane
+        //(opnienie i ogon znane po prepareToPlay, gdy tor jest ju zbudowany i zaprojektowany)
+        const auto inputLength = reader->lengthInSamples;
+        const auto totalLength = inputLength + (compensateLatency ? processor.getTailSamples() : 0);
+        auto samplesToDrop = compensateLatency ? processor.getLatencySamples() : 0;
+
+        for (juce::int64 position = 0; position < totalLength; position += blockSize)
+        {
+            if (shouldExit())
+                return jobHasFinished;
+
+            const auto numSamples = (int) juce::jmin((juce::int64) blockSize, totalLength - position);
+            const auto numInputSamples = (int) juce::jlimit((juce::int64) 0, (juce::int64) numSamples, inputLength - position);
+            juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), numChannels, numSamples);
+
+            if (numInputSamples > 0)
+                reader->read(&block, 0, numInputSamples, position, true, true);
+            block.clear(numInputSamples, numSamples - numInputSamples);
+            processor.processBlock(block, midi);
+
+            const auto skip = juce::jmin(numSamples, samplesToDrop);
+            samplesToDrop -= skip;
+            if (!writer->writeFromAudioSampleBuffer(block, skip, numSamples - skip))
+                return fail("write error");
+        }
+
+        processor.releaseResources();
+        return jobHasFinished;
+    }
+
+    const juce::File& getInput() const { return input; }
+    const juce::String& getError() const { return error; }
+
+private:
+    JobStatus fail(const juce::String& message)
+    {
+        error = message;
+        return jobHasFinished;
+    }
+
+    juce::File input, output;
+    const juce::MemoryBlock& state;
+    int blockSize;
+    bool compensateLatency;
+    juce::String error;
+};
+
+//pliki z argumentw, katalogi przeszukiwane rekurencyjnie
+static juce::Array<juce::File> findInputFiles(const juce::ArgumentList& args)
+{
+    juce::Array<juce::File> files;
+
+    for (auto& argument : args.arguments)
+    {
+        auto file = argument.resolveAsFile();
+        if (file.isDirectory())
+            files.addArray(file.findChildFiles(juce::File::findFiles, true, "*.wav;*.aif;*.aiff"));
+        else if (file.existsAsFile())
+            files.add(file);
+        else
+            std::cerr << "Skipping " << argument.text << ": not found" << std::endl;
+    }
+
+    return files;
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    //APVTS korzysta z Timera, wic potrzebny jest MessageManager
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args(argc, argv);
+
+    const auto stateFile = juce::File::getCurrentWorkingDirectory().getChildFile(args.removeValueForOption("--state"));
+    const auto outputDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(args.removeValueForOption("--out"));
+    const auto blockSize = args.containsOption("--block") ? args.removeValueForOption("--block").getIntValue() : 512;
+    const auto numThreads = args.containsOption("--threads") ? args.removeValueForOption("--threads").getIntValue()
+                                                             : juce::SystemStats::getNumCpus();
+    const auto compensateLatency = args.removeOptionIfFound("--compensate-latency");
+
+    juce::MemoryBlock state;
+    if (!stateFile.existsAsFile() || !stateFile.loadFileAsData(state))
+    {
+        std::cerr << "Usage: " << args.executableName << " --state <file> --out <directory> [--block <samples>] [--threads <count>] [--compensate-latency] <inputs>..." << std::endl;
+        return 1;
+    }
+
+    if (blockSize <= 0 || numThreads <= 0 || !outputDirectory.createDirectory())
+    {
+        std::cerr << "Invalid block size, thread count or output directory" << std::endl;
+        return 1;
+    }
+
+    juce::OwnedArray<RenderJob> jobs;
+    for (auto& input : findInputFiles(args))
+    {
+        const auto output = outputDirectory.getChildFile(input.getFileName());
+        if (output == input)
+        {
+            std::cerr << "Skipping " << input.getFullPathName() << ": output would overwrite input" << std::endl;
+            continue;
+        }
+        jobs.add(new RenderJob(input, output, state, blockSize, compensateLatency));
+    }
+
+    //jeden procesor na plik, tyle plikw naraz ile wtkw
+    {
+        juce::ThreadPool pool(numThreads);
+        for (auto* job : jobs)
+            pool.addJob(job, false);
+
+        while (pool.getNumJobs() > 0)
+            juce::Thread::sleep(50);
+    }
+
+    int failed = 0;
+    for (auto* job : jobs)
+    {
+        if (job->getError().isNotEmpty())
+        {
+            std::cerr << job->getInput().getFullPathName() << ": " << job->getError() << std::endl;
+            ++failed;
+        }
+    }
+
+    std::cout << "Rendered " << (jobs.size() - failed) << " of " << jobs.size() << " files" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,977 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+    Benchmark suite for the EQ: processBlock over block sizes, sample rates,
+    slopes, band types, bypass combinations, channel counts, filter
+    precision (float / double / auto, float and double host buffers), the
+    spectrum analyzer tap (editor closed / open), dynamic bands (off /
+    all four on), the number of enabled bands out of 24, silent input past
+    the filter tail (idle path), host bypass after the crossfade, state recall
+    in 1000 instances (binary format and legacy ValueTree blob), listing a
+    memory-mapped bank of 1000 presets and switching presets during
+    playback, the same band change in 32 identical instances sharing the
+    process-wide coefficient store, coefficient design after a parameter change (coefficient
+    cache hit and miss), reading every parameter by ID string and through
+    ParameterTable, a single HP design with the JUCE and heap-free
+    designers (and, as a check, the heap-free designers against JUCE on
+    the grid documented in StaticFilterDesign.h, within 1e-12), coefficient
+    ramps at several update granularities, the
+    SIMD cascade against the former chain of juce::dsp::IIR::Filter (throughput
+    ratio and maximum output difference, which must stay within 1e-6), output
+    gain with the old RMS meter and with the fused meter (peak, RMS, true
+    peak, loudness), FrequencyResponse::paint and the worker's curve update
+    after a band change. Build as a console application linked with the
+    plugin's Shared Code, in Release.
+
+    PJKBenchmark [--filter <text>] [--json] [--write-baseline <file>]
+                 [--baseline <file>] [--tolerance <percent>] [--allow-new]
+
+    Each case reports ns per unit (per sample for audio cases, per design for
+    design cases, per parameter read for parameter access and per call for
+    get-settings, per pixel column for paint and response) and p50/p99 of a single call in ns.
+    With --baseline the run fails when a case is slower than the baseline by
+    more than the tolerance (default 10%). It also fails when the baseline
+    file is missing, unreadable or has no cases, and when a case that ran is
+    missing from it (MISSING on stderr); --allow-new turns missing cases into
+    warnings while new cases are being added. No baseline is checked in:
+    the numbers only mean something on the machine that recorded them, so
+    record one there with --write-baseline <file> and pass the same file to
+    --baseline on later runs of that machine.
+    A failed accuracy check makes the run exit with 3, with or without --baseline.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+#include "../PluginEditor.h"
+
+//wynik jednego przypadku
+struct Result
+{
+    juce::String name;
+    double nsPerUnit{ 0 }, p50{ 0 }, p99{ 0 };
+};
+
+//ustawienia toru dla przypadkw processBlock
+struct Configuration
+{
+    int highPassSlope{ 3 }, lowPassSlope{ 3 }, bandType{ 0 }, precision{ 2 };
+    bool highPassOff{ false }, lowPassOff{ false }, bandsOff{ false };
+    //wczone pasma (pierwsze numBands z maxBands), pozostae wyczone
+    int numBands{ 4 };
+    //odczep analizatora wczony, jak przy otwartym edytorze
+    bool analyzer{ false };
+    //wczone pasma dynamiczne, prg poniej poziomu szumu - detektory cay czas zmieniaj wzmocnienie
+    bool dynamic{ false };
+    //cisza na wejciu - po ogonie filtrw procesor przechodzi w tryb bezczynny
+    bool silent{ false };
+    //obejcie przez hosta (processBlockBypassed) po zakoczonym przenikaniu
+    bool bypassed{ false };
+};
+
+static double ticksToNs(juce::int64 ticks)
+{
+    return juce::Time::highResolutionTicksToSeconds(ticks) * 1.0e9;
+}
+
+//wywouje run() tyle razy, eby przej ok. 2^20 jednostek, i zbiera czasy pojedynczych wywoa;
+//maxRuns ogranicza liczb wywoa dla bardzo dugich run()
+template<typename Function>
+static Result measure(const juce::String& name, int unitsPerRun, Function&& run, int maxRuns = 20000)
+{
+    const auto runs = juce::jlimit(juce::jmin(200, maxRuns), maxRuns, (1 << 20) / juce::jmax(1, unitsPerRun));
+
+    for (int i = 0; i < runs / 10; ++i)
+        run();
+
+    std::vector<double> times;
+    times.reserve((size_t) runs);
+
+    for (int i = 0; i < runs; ++i)
+    {
+        const auto start = juce::Time::getHighResolutionTicks();
+        run();
+        times.push_back(ticksToNs(juce::Time::getHighResolutionTicks() - start));
+    }
+
+    const auto total = std::accumulate(times.begin(), times.end(), 0.0);
+    std::sort(times.begin(), times.end());
+
+    Result result;
+    result.name = name;
+    result.nsPerUnit = total / ((double) runs * unitsPerRun);
+    result.p50 = times[times.size() / 2];
+    result.p99 = times[juce::jmin(times.size() - 1, times.size() * 99 / 100)];
+    return result;
+}
+
+static void setParameter(PJKParametricEQAudioProcessor& processor, ParameterIndex index, float value)
+{
+    auto* parameter = processor.state.getParameter(getParameterID(index));
+    parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+}
+
+static void apply(PJKParametricEQAudioProcessor& processor, const Configuration& configuration)
+{
+    setParameter(processor, HighPassFreq, 40.f);
+    setParameter(processor, HighPassSlope, (float) configuration.highPassSlope);
+    setParameter(processor, HighPassOff, configuration.highPassOff ? 1.f : 0.f);
+    setParameter(processor, LowPassFreq, 16000.f);
+    setParameter(processor, LowPassSlope, (float) configuration.lowPassSlope);
+    setParameter(processor, LowPassOff, configuration.lowPassOff ? 1.f : 0.f);
+
+    for (int i = 0; i < maxBands; ++i)
+    {
+        const auto enabled = i < configuration.numBands && !configuration.bandsOff;
+        setParameter(processor, getBandParameter(i, BandType), (float) configuration.bandType);
+        setParameter(processor, getBandParameter(i, BandGain), 6.f);
+        setParameter(processor, getBandParameter(i, BandOff), enabled ? 0.f : 1.f);
+        setParameter(processor, getBandParameter(i, BandDynamic), configuration.dynamic && enabled ? 1.f : 0.f);
+        setParameter(processor, getBandParameter(i, BandThreshold), -40.f);
+    }
+
+    setParameter(processor, Precision, (float) configuration.precision);
+}
+
+static bool setChannels(PJKParametricEQAudioProcessor& processor, int numChannels)
+{
+    //tylko gwna szyna, sidechain zostaje wyczony
+    auto layout = processor.getBusesLayout();
+    layout.inputBuses.getReference(0) = juce::AudioChannelSet::canonicalChannelSet(numChannels);
+    layout.outputBuses.getReference(0) = juce::AudioChannelSet::canonicalChannelSet(numChannels);
+    return processor.setBusesLayout(layout);
+}
+
+template<typename SampleType>
+static void fillWithNoise(juce::AudioBuffer<SampleType>& buffer)
+{
+    juce::Random random(1);
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+            buffer.setSample(channel, i, (SampleType) (random.nextFloat() * 2.f - 1.f));
+}
+
+//==============================================================================
+template<typename SampleType = float>
+static Result benchmarkProcessBlock(const juce::String& name, double sampleRate, int blockSize, int numChannels,
+    const Configuration& configuration)
+{
+    PJKParametricEQAudioProcessor processor;
+    setChannels(processor, numChannels);
+    apply(processor, configuration);
+    processor.prepareToPlay(sampleRate, blockSize);
+
+    juce::AudioBuffer<SampleType> buffer(numChannels, blockSize);
+    juce::MidiBuffer midi;
+    if (configuration.silent)
+        buffer.clear();
+    else
+        fillWithNoise(buffer);
+
+    //kolejki analizatora oprniane po kadym bloku, eby zapis do nich nie by pomijany
+    auto& tap = processor.getSpectrumTap();
+    tap.setEnabled(configuration.analyzer);
+    std::vector<float> drain((size_t) blockSize);
+
+    auto result = measure(name, blockSize, [&]
+        {
+            if (configuration.bypassed)
+                processor.processBlockBypassed(buffer, midi);
+            else
+                processor.processBlock(buffer, midi);
+            if (configuration.analyzer)
+                for (int point = 0; point < SpectrumTap::NumPoints; ++point)
+                    tap.pull((SpectrumTap::Point) point, drain.data(), blockSize);
+        });
+    processor.releaseResources();
+    return result;
+}
+
+//zmiana parametru + processBlock offline, czyli projekt sekcji i wgranie wspczynnikw;
+//repeat: przeczanie dwch wartoci (trafienia w pami podrczn), inaczej za kadym razem
+//nowa warto co 1 Hz (same chybienia - 4096 wartoci to wicej ni pojemno pamici)
+static Result benchmarkDesign(const juce::String& name, ParameterIndex index, float first, float second, bool repeat = true)
+{
+    PJKParametricEQAudioProcessor processor;
+    apply(processor, {});
+    processor.setNonRealtime(true);
+    processor.prepareToPlay(48000.0, 1);
+
+    juce::AudioBuffer<float> buffer(2, 1);
+    juce::MidiBuffer midi;
+    bool toggle = false;
+    int step = 0;
+
+    return measure(name, 1, [&]
+        {
+            toggle = !toggle;
+            const auto value = repeat ? (toggle ? first : second) : first + (float) (++step % 4096);
+            setParameter(processor, index, value);
+            processor.processBlock(buffer, midi);
+        });
+}
+
+//kaskada w trakcie cigej automatyki, wspczynniki przeliczane co subBlockSize prbek;
+//12 sekcji jak w domylnym torze (HP, 4 pasma, LP)
+static Result benchmarkRamp(int subBlockSize, int blockSize)
+{
+    constexpr int numSections = 12;
+
+    BiquadCascade<float> cascade;
+    cascade.setSmoothing(subBlockSize, 0.02);
+    cascade.prepare({ 48000.0, (juce::uint32) blockSize, 2 });
+
+    SectionCoefficients low[numSections], high[numSections];
+    for (int i = 0; i < numSections; ++i)
+    {
+        low[i] = toSectionCoefficients(juce::dsp::IIR::Coefficients<float>::makePeakFilter(48000.0, 200.f * (i + 1), 1.f, 2.f));
+        high[i] = toSectionCoefficients(juce::dsp::IIR::Coefficients<float>::makePeakFilter(48000.0, 300.f * (i + 1), 1.f, 0.5f));
+    }
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    fillWithNoise(buffer);
+    juce::dsp::AudioBlock<float> block(buffer);
+    bool toggle = false;
+
+    return measure("ramp/sub" + juce::String(subBlockSize) + "/block" + juce::String(blockSize), blockSize, [&]
+        {
+            toggle = !toggle;
+            for (int i = 0; i < numSections; ++i)
+                cascade.setSection(i, toggle ? low[i] : high[i], true);
+            cascade.process(juce::dsp::ProcessContextReplacing<float>(block));
+        });
+}
+
+//odczyt wszystkich parametrw: wyszukiwanie po ID w APVTS (jak dawne getSettings) albo przez
+//ParameterTable (wskaniki wyszukane raz); settings - cae getSettings na tablicy
+enum class ParameterAccess
+{
+    StringLookup, Table, Settings
+};
+
+static Result benchmarkParameterAccess(const juce::String& name, ParameterAccess access)
+{
+    PJKParametricEQAudioProcessor processor;
+    ParameterTable table(processor.state);
+
+    juce::StringArray ids;
+    for (int i = 0; i < NumParameters; ++i)
+        ids.add(getParameterID(i));
+
+    float sink = 0.f;
+    auto result = measure(name, access == ParameterAccess::Settings ? 1 : NumParameters, [&]
+        {
+            if (access == ParameterAccess::StringLookup)
+            {
+                for (auto& id : ids)
+                    sink += processor.state.getRawParameterValue(id)->load(std::memory_order_relaxed);
+            }
+            else if (access == ParameterAccess::Table)
+            {
+                for (int i = 0; i < NumParameters; ++i)
+                    sink += table.get((ParameterIndex) i);
+            }
+            else
+            {
+                sink += getSettings(table).gain;
+            }
+        });
+
+    juce::ignoreUnused(sink);
+    return result;
+}
+
+//kontrole poprawnoci (nie czasu), ktre nie przeszy - kod wyjcia 3
+static int failedChecks = 0;
+
+//dawny tor jednego kanau: HP (4 sekcje), 4 pasma, LP (4 sekcje), po IIR::Filter na sekcj
+using LegacyMonoChain = juce::dsp::ProcessorChain<Filter, Filter, Filter, Filter, Filter, Filter,
+                                                  Filter, Filter, Filter, Filter, Filter, Filter>;
+constexpr int legacyChainSections = 12;
+
+template<size_t... Index>
+static void setLegacySections(LegacyMonoChain& chain, const std::array<SectionCoefficients, legacyChainSections>& sections,
+    std::index_sequence<Index...>)
+{
+    (..., (chain.get<Index>().coefficients = new juce::dsp::IIR::Coefficients<float>(
+        (float) sections[Index].b0, (float) sections[Index].b1, (float) sections[Index].b2,
+        1.f, (float) sections[Index].a1, (float) sections[Index].a2)));
+}
+
+//BiquadCascade i dawny tor na tych samych wspczynnikach i wejciu: przepustowo obu (dwa przypadki),
+//a na stderr ich stosunek i najwiksza rnica wyj po sekundzie szumu, sprawdzana z tolerancj 1e-6
+//podan w BiquadCascade.h
+static juce::Array<Result> benchmarkCascadeVersusChain(int blockSize)
+{
+    constexpr double sampleRate = 48000.0, tolerance = 1.0e-6;
+    constexpr int numSamples = 48000;
+
+    std::array<SectionCoefficients, legacyChainSections> sections;
+    const auto highPass = StaticFilterDesign::designButterworthHighPass(40.0, sampleRate, 8);
+    const auto lowPass = StaticFilterDesign::designButterworthLowPass(16000.0, sampleRate, 8);
+    for (size_t i = 0; i < 4; ++i)
+    {
+        sections[i] = highPass.sections[i];
+        sections[4 + i] = StaticFilterDesign::makePeakFilter(sampleRate, 250.0 * (double) (i + 1), 1.0, 2.0);
+        sections[8 + i] = lowPass.sections[i];
+    }
+
+    BiquadCascade<float> cascade;
+    cascade.prepare({ sampleRate, (juce::uint32) blockSize, 2 });
+    for (int i = 0; i < legacyChainSections; ++i)
+        cascade.setSectionTarget(i, sections[(size_t) i], true);
+    cascade.commitSections();
+    //od razu docelowe wspczynniki, bez rampy i przenikania wczania
+    cascade.reset();
+
+    std::array<LegacyMonoChain, 2> chains;
+    for (auto& chain : chains)
+    {
+        setLegacySections(chain, sections, std::make_index_sequence<legacyChainSections>());
+        chain.prepare({ sampleRate, (juce::uint32) blockSize, 1 });
+    }
+
+    auto processChains = [&](juce::dsp::AudioBlock<float> block)
+    {
+        for (size_t channel = 0; channel < chains.size(); ++channel)
+        {
+            auto mono = block.getSingleChannelBlock(channel);
+            chains[channel].process(juce::dsp::ProcessContextReplacing<float>(mono));
+        }
+    };
+
+    //dokadno: oba tory od czystego stanu, to samo wejcie w blokach blockSize
+    juce::AudioBuffer<float> viaCascade(2, numSamples);
+    fillWithNoise(viaCascade);
+    juce::AudioBuffer<float> viaChain(viaCascade);
+    juce::dsp::AudioBlock<float> cascadeBlock(viaCascade), chainBlock(viaChain);
+
+    for (int offset = 0; offset < numSamples; offset += blockSize)
+    {
+        const auto length = (size_t) juce::jmin(blockSize, numSamples - offset);
+        cascade.process(juce::dsp::ProcessContextReplacing<float>(cascadeBlock.getSubBlock((size_t) offset, length)));
+        processChains(chainBlock.getSubBlock((size_t) offset, length));
+    }
+
+    double maxDifference = 0.0;
+    for (int channel = 0; channel < 2; ++channel)
+        for (int i = 0; i < numSamples; ++i)
+            maxDifference = juce::jmax(maxDifference, std::abs((double) viaCascade.getSample(channel, i) - (double) viaChain.getSample(channel, i)));
+
+    //przepustowo: za kadym razem to samo wejcie, eby wielokrotne filtrowanie nie zmieniao poziomu
+    juce::AudioBuffer<float> noise(2, blockSize), work(2, blockSize);
+    fillWithNoise(noise);
+    juce::dsp::AudioBlock<float> workBlock(work);
+
+    const auto name = "cascade/block" + juce::String(blockSize);
+    juce::Array<Result> results;
+    results.add(measure(name + "/biquad-cascade", blockSize, [&]
+        {
+            work.makeCopyOf(noise, true);
+            cascade.process(juce::dsp::ProcessContextReplacing<float>(workBlock));
+        }));
+    results.add(measure(name + "/iir-filter-chain", blockSize, [&]
+        {
+            work.makeCopyOf(noise, true);
+            processChains(workBlock);
+        }));
+
+    const auto passed = maxDifference <= tolerance;
+    failedChecks += passed ? 0 : 1;
+    std::cerr << name << ": BiquadCascade " << juce::String(results[1].nsPerUnit / results[0].nsPerUnit, 2)
+              << "x the throughput of the IIR::Filter chain; max difference " << juce::String(maxDifference, 9)
+              << (passed ? " <= " : " > ") << tolerance << (passed ? "" : "  ERROR: accuracy check failed") << std::endl;
+
+    return results;
+}
+
+//sam projekt HP 48 dB/oct: juce::dsp::FilterDesign (sterta) i StaticFilterDesign (std::array)
+static Result benchmarkDesigner(bool useStatic)
+{
+    double frequency = 20.0, sink = 0.0;
+
+    auto result = measure(useStatic ? "designer/static-highpass8" : "designer/juce-highpass8", 1, [&]
+        {
+            frequency = frequency < 20000.0 ? frequency * 1.01 : 20.0;
+            if (useStatic)
+                sink += StaticFilterDesign::designButterworthHighPass(frequency, 48000.0, 8).sections[3].a2;
+            else
+                sink += juce::dsp::FilterDesign<double>::designIIRHighpassHighOrderButterworthMethod(frequency, 48000.0, 8)[3]->coefficients[4];
+        });
+
+    juce::ignoreUnused(sink);
+    return result;
+}
+
+//wspczynniki JUCE jako sekcja; sekcja pierwszego rzdu ma w JUCE tylko b0, b1, a1
+static SectionCoefficients toSection(const juce::dsp::IIR::Coefficients<double>& coefficients)
+{
+    const auto& c = coefficients.coefficients;
+    if (c.size() == 3)
+        return { c[0], c[1], 0.0, c[2], 0.0 };
+    return { c[0], c[1], c[2], c[3], c[4] };
+}
+
+static double getMaxDifference(const SectionCoefficients& a, const SectionCoefficients& b)
+{
+    return juce::jmax(juce::jmax(std::abs(a.b0 - b.b0), std::abs(a.b1 - b.b1), std::abs(a.b2 - b.b2)),
+                      std::abs(a.a1 - b.a1), std::abs(a.a2 - b.a2));
+}
+
+//StaticFilterDesign wzgldem juce::dsp::IIR::Coefficients<double> i FilterDesign<double> na siatce
+//z opisu w StaticFilterDesign.h: 20 Hz - 0.45 fs, Q 0.1-10, +-20 dB, Butterworth rzdu 2-8;
+//najwiksza rnica znormalizowanego wspczynnika na stderr, sprawdzana z tolerancj 1e-12
+static void checkStaticDesigner()
+{
+    using JuceCoefficients = juce::dsp::IIR::Coefficients<double>;
+    constexpr double tolerance = 1.0e-12;
+    constexpr int frequencySteps = 60, qualitySteps = 12;
+
+    double maxBand = 0.0, maxButterworth = 0.0;
+
+    for (auto sampleRate : { 44100.0, 48000.0, 96000.0, 192000.0 })
+    {
+        for (int f = 0; f <= frequencySteps; ++f)
+        {
+            const auto frequency = 20.0 * std::pow(0.45 * sampleRate / 20.0, f / (double) frequencySteps);
+
+            for (int q = 0; q <= qualitySteps; ++q)
+            {
+                const auto quality = 0.1 * std::pow(100.0, q / (double) qualitySteps);
+
+                for (int gain = -20; gain <= 20; gain += 2)
+                {
+                    const auto gainFactor = juce::Decibels::decibelsToGain((double) gain);
+                    maxBand = juce::jmax(maxBand,
+                        getMaxDifference(StaticFilterDesign::makePeakFilter(sampleRate, frequency, quality, gainFactor),
+                                         toSection(*JuceCoefficients::makePeakFilter(sampleRate, frequency, quality, gainFactor))),
+                        getMaxDifference(StaticFilterDesign::makeLowShelf(sampleRate, frequency, quality, gainFactor),
+                                         toSection(*JuceCoefficients::makeLowShelf(sampleRate, frequency, quality, gainFactor))),
+                        getMaxDifference(StaticFilterDesign::makeHighShelf(sampleRate, frequency, quality, gainFactor),
+                                         toSection(*JuceCoefficients::makeHighShelf(sampleRate, frequency, quality, gainFactor))));
+                }
+            }
+
+            for (int order = 2; order <= 8; ++order)
+            {
+                const auto highPass = StaticFilterDesign::designButterworthHighPass(frequency, sampleRate, order);
+                const auto lowPass = StaticFilterDesign::designButterworthLowPass(frequency, sampleRate, order);
+                const auto juceHighPass = juce::dsp::FilterDesign<double>::designIIRHighpassHighOrderButterworthMethod(frequency, sampleRate, order);
+                const auto juceLowPass = juce::dsp::FilterDesign<double>::designIIRLowpassHighOrderButterworthMethod(frequency, sampleRate, order);
+
+                //inna liczba sekcji to te bd
+                if (highPass.numSections != juceHighPass.size() || lowPass.numSections != juceLowPass.size())
+                {
+                    maxButterworth = std::numeric_limits<double>::infinity();
+                    continue;
+                }
+
+                for (int i = 0; i < highPass.numSections; ++i)
+                    maxButterworth = juce::jmax(maxButterworth,
+                        getMaxDifference(highPass.sections[(size_t) i], toSection(*juceHighPass[i])),
+                        getMaxDifference(lowPass.sections[(size_t) i], toSection(*juceLowPass[i])));
+            }
+        }
+    }
+
+    const auto passed = maxBand <= tolerance && maxButterworth <= tolerance;
+    failedChecks += passed ? 0 : 1;
+    std::cerr << "designer: StaticFilterDesign against JUCE, max coefficient difference peak/shelf "
+              << maxBand << ", Butterworth " << maxButterworth
+              << (passed ? " <= " : " > ") << tolerance << (passed ? "" : "  ERROR: accuracy check failed") << std::endl;
+}
+
+//wzmocnienie kocowe z miernikiem: poprzedni sposb (juce::dsp::Gain i osobne getRMSLevel na kana,
+//tylko RMS) i OutputMeter (jedno przejcie: szczyt, RMS, szczyt rzeczywisty, gono)
+static Result benchmarkMeter(bool fused, int blockSize)
+{
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    fillWithNoise(buffer);
+    juce::dsp::AudioBlock<float> block(buffer);
+    float sink = 0, gainDecibels = 0.f;
+
+    juce::dsp::Gain<float> gain;
+    gain.prepare({ 48000.0, (juce::uint32) blockSize, 2 });
+    gain.setRampDurationSeconds(0.01);
+
+    OutputMeter meter;
+    meter.prepare(48000.0, 2, blockSize);
+
+    const auto name = juce::String(fused ? "meter/fused" : "meter/gain-rms") + "/block" + juce::String(blockSize);
+    auto result = measure(name, blockSize, [&]
+        {
+            //wzmocnienie bliskie 1, eby szum w buforze nie narasta ani nie zanika
+            gainDecibels = gainDecibels == 0.f ? 0.001f : 0.f;
+            if (fused)
+            {
+                meter.setGainDecibels(gainDecibels);
+                meter.process(block);
+                sink += meter.getRMS(0);
+            }
+            else
+            {
+                gain.setGainDecibels(gainDecibels);
+                gain.process(juce::dsp::ProcessContextReplacing<float>(block));
+                for (int channel = 0; channel < 2; ++channel)
+                    sink += juce::Decibels::gainToDecibels(buffer.getRMSLevel(channel, 0, blockSize));
+            }
+        });
+
+    juce::ignoreUnused(sink);
+    return result;
+}
+
+//samo rysowanie gotowej krzywej; krzywa liczona w tle przez ResponseWorker
+static Result benchmarkPaint(int width, int height)
+{
+    PJKParametricEQAudioProcessor processor;
+    apply(processor, {});
+    processor.prepareToPlay(48000.0, 512);
+
+    FrequencyResponse response(processor);
+    response.setSize(width, height);
+    juce::Thread::sleep(200);
+    response.timerCallback();
+
+    juce::Image image(juce::Image::RGB, width, height, true);
+    juce::Graphics g(image);
+
+    return measure("paint/" + juce::String(width) + "x" + juce::String(height), width, [&] { response.paint(g); });
+}
+
+//praca wtku roboczego po zmianie jednego pasma: wektor tej sekcji, suma i nowa cieka
+static Result benchmarkResponseUpdate(int width)
+{
+    ResponseRenderer renderer;
+    renderer.setGrid(width, 48000.0);
+
+    const auto highPass = StaticFilterDesign::designButterworthHighPass(40.0, 48000.0, 8);
+    const auto lowPass = StaticFilterDesign::designButterworthLowPass(16000.0, 48000.0, 8);
+    for (int i = 0; i < 4; ++i)
+    {
+        renderer.setSection(i, highPass.sections[(size_t) i], true);
+        renderer.setSection(ChainCoefficients::firstBandSection + i, StaticFilterDesign::makePeakFilter(48000.0, 250.0 * (i + 1), 1.0, 2.0), true);
+        renderer.setSection(ChainCoefficients::firstLowPassSection + i, lowPass.sections[(size_t) i], true);
+    }
+
+    const auto first = StaticFilterDesign::makePeakFilter(48000.0, 1000.0, 1.0, 2.0);
+    const auto second = StaticFilterDesign::makePeakFilter(48000.0, 1200.0, 1.0, 2.0);
+    const juce::Rectangle<float> bounds(0.f, 0.f, (float) width, 300.f);
+    bool toggle = false;
+
+    return measure("response/band/" + juce::String(width), width, [&]
+        {
+            toggle = !toggle;
+            renderer.setSection(ChainCoefficients::firstBandSection, toggle ? first : second, true);
+            renderer.getPath(bounds, -20.f, 20.f);
+        });
+}
+
+//wczytanie sesji: setStateInformation w 1000 instancjach, na zmian dwa rne stany (zmienia si
+//kade wczone pasmo); legacy - dawny zapis caego drzewa ValueTree
+static Result benchmarkRecall(const juce::String& name, bool legacy)
+{
+    constexpr int numInstances = 1000;
+    std::vector<std::unique_ptr<PJKParametricEQAudioProcessor>> processors;
+    for (int i = 0; i < numInstances; ++i)
+        processors.push_back(std::make_unique<PJKParametricEQAudioProcessor>());
+
+    std::array<juce::MemoryBlock, 2> states;
+    for (int i = 0; i < 2; ++i)
+    {
+        PJKParametricEQAudioProcessor source;
+        Configuration configuration;
+        configuration.bandType = i;
+        configuration.numBands = maxBands;
+        apply(source, configuration);
+
+        if (legacy)
+        {
+            //zapis parametrw do drzewa odbywa si w timerze APVTS - tutaj wymuszony
+            auto tree = source.state.copyState();
+            juce::MemoryOutputStream stream(states[(size_t) i], false);
+            tree.writeToStream(stream);
+        }
+        else
+        {
+            source.getStateInformation(states[(size_t) i]);
+        }
+    }
+
+    bool toggle = false;
+    return measure(name, numInstances, [&]
+        {
+            toggle = !toggle;
+            const auto& blob = states[toggle ? 1 : 0];
+            for (auto& processor : processors)
+                processor->setStateInformation(blob.getData(), (int) blob.getSize());
+        }, 50);
+}
+
+//bank 1000 presetw w pliku tymczasowym; switching - setCurrentProgram (cay tor do projektu w wtku projektu)
+//i blok 512 prbek z przenikaniem, inaczej lista wszystkich nazw, jak przy otwieraniu listy w hocie
+static Result benchmarkPresetBank(const juce::String& name, bool switching)
+{
+    constexpr int numPresets = 1000;
+    juce::TemporaryFile bankFile(".pjkbank");
+
+    juce::Array<PresetBank::Preset> presets;
+    {
+        PJKParametricEQAudioProcessor source;
+        for (int i = 0; i < numPresets; ++i)
+        {
+            Configuration configuration;
+            configuration.bandType = i % 3;
+            configuration.numBands = 1 + i % maxBands;
+            apply(source, configuration);
+            setParameter(source, getBandParameter(0, BandFreq), 100.f + (float) i);
+
+            PresetBank::Preset preset;
+            preset.name = "Preset " + juce::String(i + 1);
+            source.getStateInformation(preset.state);
+            presets.add(preset);
+        }
+    }
+    PresetBank::write(bankFile.getFile(), presets);
+
+    PJKParametricEQAudioProcessor processor;
+    processor.openPresetBank(bankFile.getFile());
+
+    if (!switching)
+    {
+        return measure(name, numPresets, [&]
+            {
+                for (int i = 0; i < processor.getNumPrograms(); ++i)
+                    processor.getProgramName(i);
+            });
+    }
+
+    setChannels(processor, 2);
+    processor.prepareToPlay(48000.0, 512);
+
+    juce::AudioBuffer<float> buffer(2, 512);
+    juce::MidiBuffer midi;
+    fillWithNoise(buffer);
+
+    int program = 0;
+    auto result = measure(name, 512, [&]
+        {
+            program = (program + 1) % numPresets;
+            processor.setCurrentProgram(program);
+            processor.processBlock(buffer, midi);
+        });
+    processor.releaseResources();
+    return result;
+}
+
+//ta sama zmiana pasma w 32 instancjach z identycznymi ustawieniami (szablony emisyjne): projekt
+//liczy tylko pierwsza instancja, pozostae bior sekcje ze wsplnej pamici; nowa warto co 1 Hz.
+//Koszt na instancj oraz pami wspczynnikw trafiaj na stderr, eby nie psu wyjcia --json
+static Result benchmarkSharedDesign(const juce::String& name)
+{
+    constexpr int numInstances = 32;
+    std::vector<std::unique_ptr<PJKParametricEQAudioProcessor>> processors;
+    for (int i = 0; i < numInstances; ++i)
+    {
+        auto processor = std::make_unique<PJKParametricEQAudioProcessor>();
+        apply(*processor, {});
+        processor->setNonRealtime(true);
+        processor->prepareToPlay(48000.0, 1);
+        processors.push_back(std::move(processor));
+    }
+
+    juce::AudioBuffer<float> buffer(2, 1);
+    juce::MidiBuffer midi;
+    int step = 0;
+
+    auto result = measure(name, numInstances, [&]
+        {
+            const auto value = 1000.f + (float) (++step % 4096);
+            for (auto& processor : processors)
+            {
+                setParameter(*processor, getBandParameter(0, BandFreq), value);
+                processor->processBlock(buffer, midi);
+            }
+        }, 2000);
+
+    const auto first = processors.front()->getDesignStatistics();
+    const auto other = processors.back()->getDesignStatistics();
+    std::cerr << name << ": " << (int) first.instanceBytes << " B per instance, shared store "
+              << (int) first.sharedBytes << " B for " << first.sharingInstances << " instances; sections designed "
+              << (int) first.sectionsDesigned << "/" << (int) first.sectionsRequested << " (first instance, "
+              << juce::String(first.designSeconds * 1.0e9 / (double) juce::jmax((juce::uint64) 1, first.designPasses), 0) << " ns/pass), "
+              << (int) other.sectionsDesigned << "/" << (int) other.sectionsRequested << " (last instance, "
+              << juce::String(other.designSeconds * 1.0e9 / (double) juce::jmax((juce::uint64) 1, other.designPasses), 0) << " ns/pass)"
+              << std::endl;
+
+    for (auto& processor : processors)
+        processor->releaseResources();
+    return result;
+}
+
+//==============================================================================
+static juce::Array<Result> runAll(const juce::String& filter)
+{
+    juce::Array<Result> results;
+    auto run = [&](const juce::String& name, auto&& benchmark)
+    {
+        if (filter.isEmpty() || name.contains(filter))
+            results.add(benchmark());
+    };
+
+    const Configuration full;
+
+    for (auto blockSize : { 1, 16, 64, 256, 1024, 8192 })
+    {
+        const auto name = "process/block" + juce::String(blockSize);
+        run(name, [&] { return benchmarkProcessBlock(name, 48000.0, blockSize, 2, full); });
+    }
+
+    for (auto sampleRate : { 44100.0, 48000.0, 96000.0, 192000.0 })
+    {
+        const auto name = "process/rate" + juce::String((int) sampleRate);
+        run(name, [&] { return benchmarkProcessBlock(name, sampleRate, 512, 2, full); });
+    }
+
+    for (int slope = 0; slope < 4; ++slope)
+    {
+        auto configuration = full;
+        configuration.highPassSlope = configuration.lowPassSlope = slope;
+        const auto name = "process/slope" + juce::String(slope);
+        run(name, [&] { return benchmarkProcessBlock(name, 48000.0, 512, 2, configuration); });
+    }
+
+    const char* typeNames[] = { "peak", "lowshelf", "highshelf" };
+    for (int type = 0; type < 3; ++type)
+    {
+        auto configuration = full;
+        configuration.bandType = type;
+        const auto name = juce::String("process/type-") + typeNames[type];
+        run(name, [&] { return benchmarkProcessBlock(name, 48000.0, 512, 2, configuration); });
+    }
+
+    for (int mask = 0; mask < 8; ++mask)
+    {
+        auto configuration = full;
+        configuration.highPassOff = (mask & 1) != 0;
+        configuration.lowPassOff = (mask & 2) != 0;
+        configuration.bandsOff = (mask & 4) != 0;
+        const auto name = "process/bypass-hp" + juce::String(mask & 1) + "-lp" + juce::String((mask >> 1) & 1)
+                        + "-bands" + juce::String((mask >> 2) & 1);
+        run(name, [&] { return benchmarkProcessBlock(name, 48000.0, 512, 2, configuration); });
+    }
+
+    for (auto numChannels : { 1, 2, 6, 12, 16 })
+    {
+        const auto name = "process/channels" + juce::String(numChannels);
+        run(name, [&] { return benchmarkProcessBlock(name, 48000.0, 512, numChannels, full); });
+    }
+
+    //HP 40 Hz w trybie auto trafia do kaskady double, reszta zostaje w float
+    const char* precisionNames[] = { "float", "double", "auto" };
+    for (int precision = 0; precision < 3; ++precision)
+    {
+        auto configuration = full;
+        configuration.precision = precision;
+        const auto name = juce::String("process/precision-") + precisionNames[precision];
+        run(name, [&] { return benchmarkProcessBlock(name, 48000.0, 512, 2, configuration); });
+
+        const auto hostName = name + "-host-double";
+        run(hostName, [&] { return benchmarkProcessBlock<double>(hostName, 48000.0, 512, 2, configuration); });
+    }
+
+    for (auto analyzer : { false, true })
+    {
+        auto configuration = full;
+        configuration.analyzer = analyzer;
+        const auto name = juce::String("process/analyzer-") + (analyzer ? "on" : "off");
+        run(name, [&] { return benchmarkProcessBlock(name, 48000.0, 512, 2, configuration); });
+    }
+
+    for (auto dynamic : { false, true })
+    {
+        auto configuration = full;
+        configuration.dynamic = dynamic;
+        const auto name = juce::String("process/dynamic-") + (dynamic ? "on" : "off");
+        run(name, [&] { return benchmarkProcessBlock(name, 48000.0, 512, 2, configuration); });
+    }
+
+    //koszt zaley od liczby wczonych pasm, nie od maxBands
+    for (auto numBands : { 3, 4, maxBands })
+    {
+        auto configuration = full;
+        configuration.numBands = numBands;
+        const auto name = "process/bands" + juce::String(numBands) + "of" + juce::String(maxBands);
+        run(name, [&] { return benchmarkProcessBlock(name, 48000.0, 512, 2, configuration); });
+    }
+
+    {
+        auto configuration = full;
+        configuration.silent = true;
+        run("process/silent", [&] { return benchmarkProcessBlock("process/silent", 48000.0, 512, 2, configuration); });
+    }
+
+    {
+        auto configuration = full;
+        configuration.bypassed = true;
+        run("process/bypassed", [&] { return benchmarkProcessBlock("process/bypassed", 48000.0, 512, 2, configuration); });
+    }
+
+    run("state/recall-binary/1000", [&] { return benchmarkRecall("state/recall-binary/1000", false); });
+    run("state/recall-valuetree/1000", [&] { return benchmarkRecall("state/recall-valuetree/1000", true); });
+
+    run("preset/list/1000", [&] { return benchmarkPresetBank("preset/list/1000", false); });
+    run("preset/switch", [&] { return benchmarkPresetBank("preset/switch", true); });
+
+    run("design/shared/32-instances", [&] { return benchmarkSharedDesign("design/shared/32-instances"); });
+
+    run("parameters/string-lookup", [&] { return benchmarkParameterAccess("parameters/string-lookup", ParameterAccess::StringLookup); });
+    run("parameters/table", [&] { return benchmarkParameterAccess("parameters/table", ParameterAccess::Table); });
+    run("parameters/get-settings", [&] { return benchmarkParameterAccess("parameters/get-settings", ParameterAccess::Settings); });
+
+    run("design/band", [&] { return benchmarkDesign("design/band", getBandParameter(0, BandFreq), 1000.f, 1200.f); });
+    run("design/highpass", [&] { return benchmarkDesign("design/highpass", HighPassFreq, 40.f, 60.f); });
+    run("design/band-miss", [&] { return benchmarkDesign("design/band-miss", getBandParameter(0, BandFreq), 1000.f, 0.f, false); });
+    run("design/highpass-miss", [&] { return benchmarkDesign("design/highpass-miss", HighPassFreq, 20.f, 0.f, false); });
+
+    for (auto subBlockSize : { 8, 16, 32, 64 })
+        for (auto blockSize : { 64, 1024 })
+            run("ramp/sub" + juce::String(subBlockSize) + "/block" + juce::String(blockSize),
+                [&] { return benchmarkRamp(subBlockSize, blockSize); });
+
+    for (auto blockSize : { 64, 512 })
+    {
+        const auto name = "cascade/block" + juce::String(blockSize);
+        if (filter.isEmpty() || name.contains(filter))
+            results.addArray(benchmarkCascadeVersusChain(blockSize));
+    }
+
+    //kontrola dokadnoci razem z przypadkami projektanta
+    if (filter.isEmpty() || juce::String("designer/static-highpass8").contains(filter))
+        checkStaticDesigner();
+    run("designer/juce-highpass8", [&] { return benchmarkDesigner(false); });
+    run("designer/static-highpass8", [&] { return benchmarkDesigner(true); });
+
+    for (auto blockSize : { 64, 512 })
+    {
+        run("meter/gain-rms/block" + juce::String(blockSize), [&] { return benchmarkMeter(false, blockSize); });
+        run("meter/fused/block" + juce::String(blockSize), [&] { return benchmarkMeter(true, blockSize); });
+    }
+
+    run("paint/1200x300", [&] { return benchmarkPaint(1200, 300); });
+    run("paint/3840x960", [&] { return benchmarkPaint(3840, 960); });
+    run("response/band/1200", [&] { return benchmarkResponseUpdate(1200); });
+    run("response/band/3840", [&] { return benchmarkResponseUpdate(3840); });
+
+    return results;
+}
+
+static juce::var toJSON(const juce::Array<Result>& results)
+{
+    auto* cases = new juce::DynamicObject();
+    for (auto& result : results)
+    {
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("nsPerUnit", result.nsPerUnit);
+        entry->setProperty("p50", result.p50);
+        entry->setProperty("p99", result.p99);
+        cases->setProperty(result.name, juce::var(entry));
+    }
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("machine", juce::SystemStats::getCpuModel());
+    root->setProperty("cases", juce::var(cases));
+    return juce::var(root);
+}
+
+//porwnanie z zapisanym wynikiem, zwraca liczb bdw: regresji i przypadkw, ktrych nie ma
+//w bazie (bez allowNew) - inaczej nowy albo przemianowany przypadek nigdy nie byby sprawdzany
+static int compareWithBaseline(const juce::Array<Result>& results, const juce::var& baseline, double tolerancePercent,
+    bool allowNew)
+{
+    int failures = 0;
+    const auto cases = baseline["cases"];
+
+    for (auto& result : results)
+    {
+        const auto reference = (double) cases[juce::Identifier(result.name)]["nsPerUnit"];
+        if (reference <= 0.0)
+        {
+            std::cerr << (allowNew ? "WARNING: " : "ERROR: ") << "MISSING    " << result.name
+                      << " has no baseline - record it with --write-baseline" << std::endl;
+            failures += allowNew ? 0 : 1;
+            continue;
+        }
+
+        const auto change = (result.nsPerUnit / reference - 1.0) * 100.0;
+        const bool regressed = change > tolerancePercent;
+        failures += regressed ? 1 : 0;
+
+        std::cout << (regressed ? "REGRESSION " : "ok         ") << result.name << "  "
+                  << juce::String(change, 1) << "%" << std::endl;
+    }
+
+    return failures;
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    //edytor i APVTS potrzebuj MessageManagera
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args(argc, argv);
+    const bool json = args.removeOptionIfFound("--json");
+    const auto filter = args.removeValueForOption("--filter");
+    const auto baselineFile = args.removeValueForOption("--baseline");
+    const auto writeBaselineFile = args.removeValueForOption("--write-baseline");
+    const auto tolerance = args.containsOption("--tolerance") ? args.removeValueForOption("--tolerance").getDoubleValue() : 10.0;
+    const bool allowNew = args.removeOptionIfFound("--allow-new");
+
+    const auto results = runAll(filter);
+
+    if (json)
+    {
+        std::cout << juce::JSON::toString(toJSON(results)) << std::endl;
+    }
+    else
+    {
+        std::cout << juce::String("case").paddedRight(' ', 40) << "ns/unit      p50 ns       p99 ns" << std::endl;
+        for (auto& result : results)
+            std::cout << result.name.paddedRight(' ', 40)
+                      << juce::String(result.nsPerUnit, 3).paddedRight(' ', 13)
+                      << juce::String(result.p50, 0).paddedRight(' ', 13)
+                      << juce::String(result.p99, 0) << std::endl;
+    }
+
+    if (writeBaselineFile.isNotEmpty())
+        juce::File::getCurrentWorkingDirectory().getChildFile(writeBaselineFile).replaceWithText(juce::JSON::toString(toJSON(results)));
+
+    if (baselineFile.isNotEmpty())
+    {
+        //brak bazy to bd, nie cicha zgoda - porwnanie z niczym zawsze by przechodzio
+        const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(baselineFile);
+        const auto baseline = juce::JSON::parse(file);
+        const auto* cases = baseline["cases"].getDynamicObject();
+        if (!file.existsAsFile() || cases == nullptr || cases->getProperties().isEmpty())
+        {
+            std::cerr << "ERROR: baseline " << file.getFullPathName() << " is missing, unreadable or has no cases;"
+                      << " record it on this machine with --write-baseline" << std::endl;
+            return 2;
+        }
+
+        //wyniki z innego procesora nie s porwnywalne
+        const auto machine = baseline["machine"].toString();
+        if (machine != juce::SystemStats::getCpuModel())
+            std::cerr << "WARNING: baseline was recorded on \"" << machine << "\", this machine is \""
+                      << juce::SystemStats::getCpuModel() << "\"" << std::endl;
+
+        if (compareWithBaseline(results, baseline, tolerance, allowNew) > 0)
+            return 1;
+    }
+
+    return failedChecks > 0 ? 3 : 0;
+}
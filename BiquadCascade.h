@@ -0,0 +1,567 @@
+/*
+  ==============================================================================
+
+    BiquadCascade.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//wspczynniki jednej sekcji biquad, kolejno jak w juce::dsp::IIR::Coefficients (a0 = 1);
+//przechowywane w double, kaskada float zaokrgla je dopiero przy upakowaniu
+struct SectionCoefficients
+{
+    double b0{ 1.0 }, b1{ 0.0 }, b2{ 0.0 }, a1{ 0.0 }, a2{ 0.0 };
+};
+
+//kanay, na ktre dziaa sekcja: wszystkie albo tylko pierwszy / drugi kana
+//(lewy / prawy, a w trybie M/S rodek / bok); pozostae kanay tylko przy All
+enum class SectionChannels
+{
+    All, First, Second
+};
+
+//kaskada biquadw (transposed direct form II) liczona dla kilku kanaw naraz:
+//kanay le w kolejnych polach rejestru SIMD, wspczynniki s wsplne dla wszystkich.
+//Aktywne sekcje s upakowane obok siebie i liczone prbka po prbce w jednej ptli,
+//wyczone sekcje nie kosztuj nic.
+//Nowe wspczynniki nie wskakuj od razu: s interpolowane liniowo na staej siatce
+//podblokw (co subBlockSize prbek), niezalenie od rozmiaru bufora hosta. Interpolacja
+//a1/a2 nie wychodzi poza obszar stabilnoci, bo dla biquada jest on wypuky (trjkt).
+//Kolejno dziaa jest taka sama jak w juce::dsp::IIR::Filter, wic wynik zgadza si
+//z dawnym Chain z dokadnoci do 1e-6 (sprawdza to Benchmark, przypadki cascade/*).
+//SampleType = double: stan i wspczynniki w double, dla sekcji z biegunami blisko z = 1.
+//Wspczynniki s pakowane osobno dla kadej grupy kanaw, wic sekcja moe dziaa tylko
+//na pierwszym lub drugim kanale (w innych polach rejestru liczy si jako sekcja przezroczysta).
+//W trybie M/S kodowanie i dekodowanie kanaw 0 i 1 odbywa si przy przeplataniu, bez
+//dodatkowego przejcia po buforze.
+//Wczenie i wyczenie sekcji to przenikanie wyjcia sekcji z jej wejciem (y = x + g (H x - x)),
+//filtr liczy przez cay czas przenikania, wic przy wczaniu jego stan rozgrzewa si, zanim
+//wyjcie ma znaczc wag. Osobna ptla z mnoeniem przez g dziaa tylko w trakcie przenikania,
+//sekcja wyczona po jego kocu znw nie kosztuje nic.
+template<typename SampleType>
+class BiquadCascade
+{
+public:
+    using Register = juce::dsp::SIMDRegister<SampleType>;
+    static constexpr int lanes = (int) Register::SIMDNumElements;
+    //kanay 0 i 1 w tej samej grupie - potrzebne do M/S
+    static_assert(lanes >= 2, "");
+    //HP (4 sekcje), do 24 pasm, LP (4 sekcje)
+    static constexpr int maxSections = 32;
+
+    void prepare(const juce::dsp::ProcessSpec& spec)
+    {
+        sampleRate = spec.sampleRate;
+        numChannels = (int) spec.numChannels;
+        numGroups = (numChannels + lanes - 1) / lanes;
+
+        interleaved = juce::dsp::AudioBlock<Register>(interleavedData, (size_t) numGroups, spec.maximumBlockSize);
+        states.resize((size_t) (numGroups * maxSections));
+        packed.resize((size_t) numGroups);
+        updateRampSteps();
+        reset();
+    }
+
+    //pami buforw przydzielonych w prepare (bez samego obiektu)
+    size_t getMemoryBytes() const
+    {
+        return packed.capacity() * sizeof(PackedCoefficients) + states.capacity() * sizeof(SectionState)
+             + interleaved.getNumChannels() * interleaved.getNumSamples() * sizeof(Register);
+    }
+
+    //czyci stan i od razu ustawia docelowe wspczynniki (bez interpolacji)
+    void reset()
+    {
+        for (auto& state : states)
+            state = {};
+
+        current = target;
+        rampStepsRemaining = 0;
+        finishFades();
+        compact();
+    }
+
+    //co ile prbek przeliczane s wspczynniki i jak dugo trwa przejcie do nowych
+    //(take przenikanie przy wczaniu i wyczaniu sekcji)
+    void setSmoothing(int subBlockSamples, double rampSeconds)
+    {
+        jassert(subBlockSamples > 0);
+        subBlockSize = subBlockSamples;
+        rampTimeSeconds = rampSeconds;
+        updateRampSteps();
+    }
+
+    void setSection(int index, const SectionCoefficients& coefficients, bool isEnabled,
+                    SectionChannels sectionChannels = SectionChannels::All)
+    {
+        setSectionTarget(index, coefficients, isEnabled, sectionChannels);
+        commitSections();
+    }
+
+    //zmiana wielu sekcji naraz: setSectionTarget dla kadej, potem jedno commitSections(),
+    //ktre liczy ramp i pakuje wspczynniki raz dla caej kaskady
+    void setSectionTarget(int index, const SectionCoefficients& coefficients, bool isEnabled,
+                          SectionChannels sectionChannels = SectionChannels::All)
+    {
+        target[(size_t) index] = coefficients;
+        channels[(size_t) index] = sectionChannels;
+
+        //sekcja wczana po przerwie startuje z czystym stanem, od razu z docelowymi wspczynnikami
+        //i z zerow wag wyjcia; sekcja wyczana liczy dalej, a jej waga spadnie do zera
+        if (isEnabled && !active[(size_t) index])
+        {
+            current[(size_t) index] = coefficients;
+            for (int group = 0; group < numGroups; ++group)
+                states[(size_t) (group * maxSections + index)] = {};
+            mix[(size_t) index] = 0.0;
+            active[(size_t) index] = true;
+        }
+
+        if (isEnabled != enabled[(size_t) index])
+        {
+            enabled[(size_t) index] = isEnabled;
+            startFade(index);
+        }
+    }
+
+    void commitSections()
+    {
+        startRamp();
+        compact();
+    }
+
+    //natychmiastowa zmiana wspczynnikw sekcji, bez interpolacji - dla sekcji zmienianych co podblok
+    //(pasma dynamiczne), gdzie pojedyncza zmiana jest maa; interpolacja pozostaych sekcji trwa dalej
+    void setSectionCoefficients(int index, const SectionCoefficients& coefficients)
+    {
+        target[(size_t) index] = coefficients;
+        current[(size_t) index] = coefficients;
+        step[(size_t) index] = { 0.0, 0.0, 0.0, 0.0, 0.0 };
+        compact();
+    }
+
+    //kanay 0 i 1 liczone jako rodek i bok; zmiana trybu czyci stan filtrw - w trakcie
+    //odtwarzania procesor przenika wtedy stary tor z nowym (fadeCascade), jak przy zmianie presetu
+    void setMidSide(bool shouldUseMidSide)
+    {
+        if (shouldUseMidSide == midSide)
+            return;
+
+        midSide = shouldUseMidSide;
+        for (auto& state : states)
+            state = {};
+    }
+
+    bool hasActiveSections() const noexcept { return numActive != 0; }
+
+    void process(const juce::dsp::ProcessContextReplacing<SampleType>& context)
+    {
+        //wszystkie sekcje wyczone - sygna przechodzi bez zmian
+        if (numActive == 0)
+            return;
+
+        auto& block = context.getOutputBlock();
+        const auto numSamples = (int) block.getNumSamples();
+        const auto channels = juce::jmin(numChannels, (int) block.getNumChannels());
+        jassert(numSamples <= (int) interleaved.getNumSamples());
+
+        const auto groups = juce::jmin(numGroups, (channels + lanes - 1) / lanes);
+
+        const auto encodeMidSide = midSide && channels >= 2;
+
+        for (int group = 0; group < groups; ++group)
+            interleave(block, group * lanes, juce::jmin(lanes, channels - group * lanes), numSamples,
+                interleaved.getChannelPointer((size_t) group), encodeMidSide && group == 0);
+
+        //poza interpolacj i przenikaniem cay blok idzie jednym kawakiem
+        for (int offset = 0; offset < numSamples;)
+        {
+            auto length = numSamples - offset;
+
+            if (numFading > 0)
+                length = juce::jmin(length, getSamplesToFadeEnd());
+
+            if (rampStepsRemaining > 0)
+            {
+                if (samplesUntilStep == 0)
+                {
+                    advanceRamp();
+                    samplesUntilStep = subBlockSize;
+                }
+                length = juce::jmin(length, samplesUntilStep);
+                samplesUntilStep -= length;
+            }
+
+            for (int group = 0; group < groups; ++group)
+                (this->*kernel)(packed[(size_t) group], states.data() + group * maxSections,
+                    interleaved.getChannelPointer((size_t) group) + offset, length);
+
+            offset += length;
+
+            if (numFading > 0)
+                advanceFades(length);
+        }
+
+        for (int group = 0; group < groups; ++group)
+            deinterleave(interleaved.getChannelPointer((size_t) group), group * lanes,
+                juce::jmin(lanes, channels - group * lanes), numSamples, block, encodeMidSide && group == 0);
+    }
+
+private:
+    struct SectionState
+    {
+        Register s1, s2;
+    };
+
+    //aktywne sekcje upakowane od pocztku tablic, osobno dla kadej grupy kanaw;
+    //waga wyjcia i jej przyrost na prbk uywane tylko w ptli przenikania
+    struct PackedCoefficients
+    {
+        std::array<Register, maxSections> b0, b1, b2, a1, a2;
+        std::array<SampleType, maxSections> mix, mixStep;
+    };
+
+    using Kernel = void (BiquadCascade::*)(const PackedCoefficients&, SectionState*, Register*, int) const noexcept;
+
+    //ptla dla staej liczby aktywnych sekcji - kompilator rozwija ptl po sekcjach,
+    //a stan trzyma w zmiennych lokalnych przez cay blok
+    template<int count>
+    void processFused(const PackedCoefficients& coefficients, SectionState* groupStates, Register* data, int numSamples) const noexcept
+    {
+        const auto& b0 = coefficients.b0;
+        const auto& b1 = coefficients.b1;
+        const auto& b2 = coefficients.b2;
+        const auto& a1 = coefficients.a1;
+        const auto& a2 = coefficients.a2;
+
+        std::array<Register, count> s1, s2;
+        for (int k = 0; k < count; ++k)
+        {
+            s1[k] = groupStates[activeIndex[k]].s1;
+            s2[k] = groupStates[activeIndex[k]].s2;
+        }
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            auto x = data[n];
+            for (int k = 0; k < count; ++k)
+            {
+                const auto out = (x * b0[k]) + s1[k];
+                s1[k] = (x * b1[k]) - (out * a1[k]) + s2[k];
+                s2[k] = (x * b2[k]) - (out * a2[k]);
+                x = out;
+            }
+            data[n] = x;
+        }
+
+        for (int k = 0; k < count; ++k)
+        {
+            groupStates[activeIndex[k]].s1 = s1[k];
+            groupStates[activeIndex[k]].s2 = s2[k];
+        }
+    }
+
+    //jak processFused, ale wyjcie kadej sekcji jest mieszane z jej wejciem; stan filtra
+    //liczony z penego wyjcia sekcji, wic po przenikaniu do g = 1 jest taki sam jak bez niego
+    template<int count>
+    void processFading(const PackedCoefficients& coefficients, SectionState* groupStates, Register* data, int numSamples) const noexcept
+    {
+        const auto& b0 = coefficients.b0;
+        const auto& b1 = coefficients.b1;
+        const auto& b2 = coefficients.b2;
+        const auto& a1 = coefficients.a1;
+        const auto& a2 = coefficients.a2;
+
+        std::array<Register, count> s1, s2;
+        std::array<SampleType, count> g;
+        for (int k = 0; k < count; ++k)
+        {
+            s1[k] = groupStates[activeIndex[k]].s1;
+            s2[k] = groupStates[activeIndex[k]].s2;
+            g[k] = coefficients.mix[k];
+        }
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            auto x = data[n];
+            for (int k = 0; k < count; ++k)
+            {
+                const auto out = (x * b0[k]) + s1[k];
+                s1[k] = (x * b1[k]) - (out * a1[k]) + s2[k];
+                s2[k] = (x * b2[k]) - (out * a2[k]);
+                x = x + ((out - x) * g[k]);
+                g[k] += coefficients.mixStep[k];
+            }
+            data[n] = x;
+        }
+
+        for (int k = 0; k < count; ++k)
+        {
+            groupStates[activeIndex[k]].s1 = s1[k];
+            groupStates[activeIndex[k]].s2 = s2[k];
+        }
+    }
+
+    template<size_t... counts>
+    static constexpr std::array<Kernel, sizeof...(counts)> makeKernels(std::index_sequence<counts...>)
+    {
+        return { &BiquadCascade::processFused<(int) counts>... };
+    }
+
+    template<size_t... counts>
+    static constexpr std::array<Kernel, sizeof...(counts)> makeFadingKernels(std::index_sequence<counts...>)
+    {
+        return { &BiquadCascade::processFading<(int) counts>... };
+    }
+
+    void updateRampSteps()
+    {
+        rampSteps = juce::jmax(1, juce::roundToInt(rampTimeSeconds * sampleRate / subBlockSize));
+        fadeSamples = juce::jmax(1, juce::roundToInt(rampTimeSeconds * sampleRate));
+    }
+
+    //przenikanie od biecej wagi (take w poowie poprzedniego przenikania) do 0 albo 1
+    void startFade(int index)
+    {
+        const auto i = (size_t) index;
+        if (fadeRemaining[i] == 0)
+            ++numFading;
+
+        fadeRemaining[i] = fadeSamples;
+        mixStep[i] = ((enabled[i] ? 1.0 : 0.0) - mix[i]) / (double) fadeSamples;
+    }
+
+    int getSamplesToFadeEnd() const noexcept
+    {
+        auto samples = std::numeric_limits<int>::max();
+        for (int i = 0; i < maxSections; ++i)
+            if (fadeRemaining[(size_t) i] > 0)
+                samples = juce::jmin(samples, fadeRemaining[(size_t) i]);
+        return samples;
+    }
+
+    //po kawaku bloku: nowe wagi, koniec przenikania wyczonej sekcji usuwa j z kaskady
+    void advanceFades(int numSamples)
+    {
+        for (size_t i = 0; i < (size_t) maxSections; ++i)
+        {
+            if (fadeRemaining[i] == 0)
+                continue;
+
+            fadeRemaining[i] -= numSamples;
+            mix[i] += mixStep[i] * numSamples;
+
+            if (fadeRemaining[i] == 0)
+            {
+                --numFading;
+                finishFade((int) i);
+            }
+        }
+        compact();
+    }
+
+    void finishFade(int index)
+    {
+        const auto i = (size_t) index;
+        fadeRemaining[i] = 0;
+        mixStep[i] = 0.0;
+        mix[i] = enabled[i] ? 1.0 : 0.0;
+
+        if (!enabled[i] && active[i])
+        {
+            active[i] = false;
+            for (int group = 0; group < numGroups; ++group)
+                states[(size_t) group * maxSections + i] = {};
+        }
+    }
+
+    void finishFades()
+    {
+        for (int i = 0; i < maxSections; ++i)
+            finishFade(i);
+        numFading = 0;
+    }
+
+    //przejcie od biecych do docelowych wspczynnikw w rampSteps krokach
+    void startRamp()
+    {
+        const auto scale = 1.0 / (double) rampSteps;
+        for (size_t i = 0; i < (size_t) maxSections; ++i)
+        {
+            step[i].b0 = (target[i].b0 - current[i].b0) * scale;
+            step[i].b1 = (target[i].b1 - current[i].b1) * scale;
+            step[i].b2 = (target[i].b2 - current[i].b2) * scale;
+            step[i].a1 = (target[i].a1 - current[i].a1) * scale;
+            step[i].a2 = (target[i].a2 - current[i].a2) * scale;
+        }
+        rampStepsRemaining = rampSteps;
+        samplesUntilStep = 0;
+    }
+
+    void advanceRamp()
+    {
+        if (--rampStepsRemaining == 0)
+        {
+            current = target;
+        }
+        else
+        {
+            for (size_t i = 0; i < (size_t) maxSections; ++i)
+            {
+                current[i].b0 += step[i].b0;
+                current[i].b1 += step[i].b1;
+                current[i].b2 += step[i].b2;
+                current[i].a1 += step[i].a1;
+                current[i].a2 += step[i].a2;
+            }
+        }
+        compact();
+    }
+
+    //czy sekcja dziaa na danym kanale
+    bool appliesTo(int index, int channel) const noexcept
+    {
+        switch (channels[(size_t) index])
+        {
+        case SectionChannels::First:  return channel == 0;
+        case SectionChannels::Second: return channel == 1;
+        default:                      return true;
+        }
+    }
+
+    //upakowanie wspczynnikw aktywnych sekcji (struktura tablic); w polach kanaw,
+    //na ktre sekcja nie dziaa, wspczynniki sekcji przezroczystej (b0 = 1)
+    void compact()
+    {
+        numActive = 0;
+        for (int i = 0; i < maxSections; ++i)
+        {
+            if (!active[(size_t) i])
+                continue;
+
+            const auto& c = current[(size_t) i];
+            for (int group = 0; group < numGroups; ++group)
+            {
+                auto& p = packed[(size_t) group];
+                p.mix[numActive] = (SampleType) mix[(size_t) i];
+                p.mixStep[numActive] = (SampleType) mixStep[(size_t) i];
+
+                if (channels[(size_t) i] == SectionChannels::All)
+                {
+                    p.b0[numActive] = Register::expand((SampleType) c.b0);
+                    p.b1[numActive] = Register::expand((SampleType) c.b1);
+                    p.b2[numActive] = Register::expand((SampleType) c.b2);
+                    p.a1[numActive] = Register::expand((SampleType) c.a1);
+                    p.a2[numActive] = Register::expand((SampleType) c.a2);
+                    continue;
+                }
+
+                for (int lane = 0; lane < lanes; ++lane)
+                {
+                    const auto applies = appliesTo(i, group * lanes + lane);
+                    p.b0[numActive].set((size_t) lane, applies ? (SampleType) c.b0 : SampleType(1));
+                    p.b1[numActive].set((size_t) lane, applies ? (SampleType) c.b1 : SampleType(0));
+                    p.b2[numActive].set((size_t) lane, applies ? (SampleType) c.b2 : SampleType(0));
+                    p.a1[numActive].set((size_t) lane, applies ? (SampleType) c.a1 : SampleType(0));
+                    p.a2[numActive].set((size_t) lane, applies ? (SampleType) c.a2 : SampleType(0));
+                }
+            }
+            activeIndex[numActive] = i;
+            ++numActive;
+        }
+
+        static constexpr auto kernels = makeKernels(std::make_index_sequence<maxSections + 1>());
+        static constexpr auto fadingKernels = makeFadingKernels(std::make_index_sequence<maxSections + 1>());
+        kernel = numFading > 0 ? fadingKernels[(size_t) numActive] : kernels[(size_t) numActive];
+    }
+
+    //kanay grupy -> pola rejestrw, nieuywane pola zerowane; midSide - pola 0 i 1 to
+    //rodek (L + R) / 2 i bok (L - R) / 2
+    static void interleave(const juce::dsp::AudioBlock<SampleType>& block, int firstChannel, int groupChannels,
+        int numSamples, Register* data, bool midSide) noexcept
+    {
+        auto* raw = reinterpret_cast<SampleType*>(data);
+
+        if (midSide)
+        {
+            const auto* left = block.getChannelPointer((size_t) firstChannel);
+            const auto* right = block.getChannelPointer((size_t) firstChannel + 1);
+            for (int n = 0; n < numSamples; ++n)
+            {
+                raw[n * lanes] = (left[n] + right[n]) * SampleType(0.5);
+                raw[n * lanes + 1] = (left[n] - right[n]) * SampleType(0.5);
+            }
+        }
+
+        for (int lane = midSide ? 2 : 0; lane < lanes; ++lane)
+        {
+            if (lane < groupChannels)
+            {
+                const auto* channel = block.getChannelPointer((size_t) (firstChannel + lane));
+                for (int n = 0; n < numSamples; ++n)
+                    raw[n * lanes + lane] = channel[n];
+            }
+            else
+            {
+                for (int n = 0; n < numSamples; ++n)
+                    raw[n * lanes + lane] = SampleType(0);
+            }
+        }
+    }
+
+    static void deinterleave(const Register* data, int firstChannel, int groupChannels,
+        int numSamples, const juce::dsp::AudioBlock<SampleType>& block, bool midSide) noexcept
+    {
+        const auto* raw = reinterpret_cast<const SampleType*>(data);
+
+        //L = M + S, R = M - S
+        if (midSide)
+        {
+            auto* left = block.getChannelPointer((size_t) firstChannel);
+            auto* right = block.getChannelPointer((size_t) firstChannel + 1);
+            for (int n = 0; n < numSamples; ++n)
+            {
+                left[n] = raw[n * lanes] + raw[n * lanes + 1];
+                right[n] = raw[n * lanes] - raw[n * lanes + 1];
+            }
+        }
+
+        for (int lane = midSide ? 2 : 0; lane < groupChannels; ++lane)
+        {
+            auto* channel = block.getChannelPointer((size_t) (firstChannel + lane));
+            for (int n = 0; n < numSamples; ++n)
+                channel[n] = raw[n * lanes + lane];
+        }
+    }
+
+    //docelowe i biece (interpolowane) wspczynniki wszystkich sekcji
+    std::array<SectionCoefficients, maxSections> target, current, step;
+    //enabled - stan dany, active - sekcja liczona (wczona albo jeszcze wyciszana)
+    std::array<bool, maxSections> enabled{}, active{};
+    std::array<SectionChannels, maxSections> channels{};
+    //waga wyjcia sekcji (1 - peny filtr, 0 - obejcie) i przenikanie w toku
+    std::array<double, maxSections> mix{}, mixStep{};
+    std::array<int, maxSections> fadeRemaining{};
+    int fadeSamples{ 1 }, numFading{ 0 };
+    bool midSide{ false };
+
+    double sampleRate{ 44100.0 }, rampTimeSeconds{ 0.02 };
+    int subBlockSize{ 32 }, rampSteps{ 1 }, rampStepsRemaining{ 0 }, samplesUntilStep{ 0 };
+
+    std::vector<PackedCoefficients> packed;
+    std::array<int, maxSections> activeIndex{};
+    int numActive{ 0 };
+    Kernel kernel{ nullptr };
+
+    //stan filtrw: numGroups * maxSections
+    std::vector<SectionState> states;
+    int numChannels{ 0 }, numGroups{ 0 };
+
+    //bufor z przeplecionymi kanaami, wyrwnany do rozmiaru rejestru
+    juce::HeapBlock<char> interleavedData;
+    juce::dsp::AudioBlock<Register> interleaved;
+};
@@ -0,0 +1,194 @@
+/*
+  ==============================================================================
+
+    CoefficientCache.cpp
+
+  ==============================================================================
+*/
+
+#include "CoefficientCache.h"
+
+CoefficientCache::Key CoefficientCache::makePassKey(DesignType type, float frequency, int slope, double sampleRate)
+{
+    Key key;
+    key.type = type;
+    key.slope = slope;
+    key.frequency = juce::roundToInt(frequency / frequencyStep);
+    key.sampleRate = sampleRate;
+    return key;
+}
+
+CoefficientCache::Key CoefficientCache::makeBandKey(int filterType, float frequency, float quality, float gainDecibels, double sampleRate)
+{
+    Key key;
+    key.type = Peak + juce::jlimit(0, 2, filterType);
+    key.frequency = juce::roundToInt(frequency / frequencyStep);
+    key.quality = juce::roundToInt(quality / qualityStep);
+    key.gain = juce::roundToInt(gainDecibels / gainStep);
+    key.sampleRate = sampleRate;
+    return key;
+}
+
+CoefficientCache::CoefficientCache(size_t memoryBudgetBytes)
+{
+    //liczba zbiorw - potga dwjki mieszczca si w budecie
+    const auto maxSets = juce::jmax((size_t) 1, memoryBudgetBytes / (sizeof(Entry) * ways));
+    while ((size_t) numSets * 2 <= maxSets)
+        numSets *= 2;
+
+    entries.reset(new Entry[(size_t) (numSets * ways)]);
+}
+
+CoefficientCache::Sections CoefficientCache::getOrDesign(const Key& key)
+{
+    bool wasDesigned;
+    return getOrDesign(key, wasDesigned);
+}
+
+CoefficientCache::Sections CoefficientCache::getOrDesign(const Key& key, bool& wasDesigned)
+{
+    Sections result;
+    wasDesigned = !find(key, result);
+    if (!wasDesigned)
+        return result;
+
+    result = design(key);
+    insert(key, result);
+    return result;
+}
+
+bool CoefficientCache::find(const Key& key, Sections& result)
+{
+    auto* set = getSet(key);
+    Payload payload;
+
+    for (int way = 0; way < ways; ++way)
+    {
+        if (read(set[way], payload) && payload.key == key)
+        {
+            set[way].lastUsed.store(++useClock, std::memory_order_relaxed);
+            result = payload.sections;
+            hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void CoefficientCache::insert(const Key& key, const Sections& sections)
+{
+    const juce::SpinLock::ScopedLockType sl(writeLock);
+
+    //ten sam klucz (wstawiony w midzyczasie) albo najdawniej uyty wpis zbioru
+    auto* set = getSet(key);
+    auto* victim = set;
+    Payload payload;
+
+    for (int way = 0; way < ways; ++way)
+    {
+        if (read(set[way], payload) && payload.key == key)
+        {
+            victim = set + way;
+            break;
+        }
+        if (set[way].lastUsed.load(std::memory_order_relaxed) < victim->lastUsed.load(std::memory_order_relaxed))
+            victim = set + way;
+    }
+
+    payload.key = key;
+    payload.sections = sections;
+    write(*victim, payload);
+    victim->lastUsed.store(++useClock, std::memory_order_relaxed);
+}
+
+//projekt bez sterty, wynik od razu w tablicy sekcji
+CoefficientCache::Sections CoefficientCache::design(const Key& key)
+{
+    const auto frequency = key.frequency * frequencyStep;
+    const auto quality = key.quality * qualityStep;
+    const auto gain = StaticFilterDesign::Math::decibelsToGain(key.gain * gainStep);
+
+    Sections result;
+
+    switch (key.type)
+    {
+    case HighPass:
+        return StaticFilterDesign::designButterworthHighPass(frequency, key.sampleRate, 2 * (key.slope + 1));
+    case LowPass:
+        return StaticFilterDesign::designButterworthLowPass(frequency, key.sampleRate, 2 * (key.slope + 1));
+    case Peak:
+        result.sections[0] = StaticFilterDesign::makePeakFilter(key.sampleRate, frequency, quality, gain);
+        break;
+    case LowShelf:
+        result.sections[0] = StaticFilterDesign::makeLowShelf(key.sampleRate, frequency, quality, gain);
+        break;
+    case HighShelf:
+        result.sections[0] = StaticFilterDesign::makeHighShelf(key.sampleRate, frequency, quality, gain);
+        break;
+    default:
+        jassertfalse;
+        return result;
+    }
+
+    result.numSections = 1;
+    return result;
+}
+
+size_t CoefficientCache::hash(const Key& key)
+{
+    auto mix = [](juce::uint64 h, juce::uint64 value) { return (h ^ value) * 0x100000001b3ull; };
+
+    juce::uint64 sampleRateBits;
+    std::memcpy(&sampleRateBits, &key.sampleRate, sizeof(sampleRateBits));
+
+    auto h = 0xcbf29ce484222325ull;
+    h = mix(h, (juce::uint64) key.type);
+    h = mix(h, (juce::uint64) key.slope);
+    h = mix(h, (juce::uint64) (juce::uint32) key.frequency);
+    h = mix(h, (juce::uint64) (juce::uint32) key.quality);
+    h = mix(h, (juce::uint64) (juce::uint32) key.gain);
+    h = mix(h, sampleRateBits);
+    return (size_t) (h ^ (h >> 32));
+}
+
+//false, gdy wpis jest w trakcie zapisu - traktowany jak brak trafienia
+bool CoefficientCache::read(const Entry& entry, Payload& payload)
+{
+    for (int attempt = 0; attempt < 2; ++attempt)
+    {
+        const auto before = entry.sequence.load(std::memory_order_acquire);
+        if ((before & 1) != 0)
+            return false;
+
+        juce::uint64 words[payloadWords];
+        for (int i = 0; i < payloadWords; ++i)
+            words[i] = entry.words[(size_t) i].load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (entry.sequence.load(std::memory_order_relaxed) == before)
+        {
+            std::memcpy(&payload, words, sizeof(Payload));
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//tylko pod writeLock
+void CoefficientCache::write(Entry& entry, const Payload& payload)
+{
+    juce::uint64 words[payloadWords] = {};
+    std::memcpy(words, &payload, sizeof(Payload));
+
+    const auto sequence = entry.sequence.load(std::memory_order_relaxed);
+    entry.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (int i = 0; i < payloadWords; ++i)
+        entry.words[(size_t) i].store(words[i], std::memory_order_relaxed);
+
+    entry.sequence.store(sequence + 2, std::memory_order_release);
+}
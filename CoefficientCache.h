@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    CoefficientCache.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "StaticFilterDesign.h"
+
+//pami podrczna zaprojektowanych filtrw: ta sama warto parametru wracajca po chwili
+//(ptla automatyki, przeczanie presetw A/B, setStateInformation) nie jest projektowana od nowa.
+//Tablica zbiorowo-skojarzeniowa (ways wpisw w zbiorze), w zbiorze wypierany najdawniej uyty wpis.
+//Odczyt bez blokad (seqlock na wpis), zapisy serializowane SpinLockiem.
+class CoefficientCache
+{
+public:
+    enum DesignType
+    {
+        None, HighPass, LowPass, Peak, LowShelf, HighShelf
+    };
+
+    //parametry projektu po kwantyzacji - filtr jest projektowany z wartoci odtworzonych z klucza,
+    //wic wynik zaley tylko od klucza
+    struct Key
+    {
+        int type{ None }, slope{ 0 };
+        int frequency{ 0 }, quality{ 0 }, gain{ 0 };
+        double sampleRate{ 0 };
+
+        bool operator==(const Key& other) const
+        {
+            return type == other.type && slope == other.slope && frequency == other.frequency
+                && quality == other.quality && gain == other.gain && sampleRate == other.sampleRate;
+        }
+    };
+
+    //HP/LP: slope + 1 sekcji, filtry 1-4: jedna sekcja
+    using Sections = DesignedSections;
+
+    //kroki kwantyzacji: 0.01 Hz, 0.001 Q, 0.001 dB - drobniejsze ni kroki parametrw
+    static constexpr double frequencyStep = 0.01, qualityStep = 0.001, gainStep = 0.001;
+
+    static Key makePassKey(DesignType type, float frequency, int slope, double sampleRate);
+    //filterType jak w parametrze FilterN Type: 0 - peak, 1 - low shelf, 2 - high shelf
+    static Key makeBandKey(int filterType, float frequency, float quality, float gainDecibels, double sampleRate);
+
+    //liczba wpisw wynika z budetu pamici
+    explicit CoefficientCache(size_t memoryBudgetBytes = 64 * 1024);
+
+    //z pamici albo zaprojektowany i zapamitany; wasDesigned - czy ten wywoujcy liczy projekt
+    Sections getOrDesign(const Key& key);
+    Sections getOrDesign(const Key& key, bool& wasDesigned);
+    //tylko odczyt, bez blokad - mona woa z dowolnego wtku
+    bool find(const Key& key, Sections& result);
+    void insert(const Key& key, const Sections& sections);
+
+    static Sections design(const Key& key);
+
+    //statystyki do oceny skutecznoci na prawdziwych sesjach
+    juce::uint64 getHits() const { return hits.load(std::memory_order_relaxed); }
+    juce::uint64 getMisses() const { return misses.load(std::memory_order_relaxed); }
+    void resetStatistics() { hits = 0; misses = 0; }
+    int getCapacity() const { return numSets * ways; }
+    size_t getMemoryBytes() const { return sizeof(Entry) * (size_t) (numSets * ways); }
+
+private:
+    struct Payload
+    {
+        Key key;
+        Sections sections;
+    };
+
+    //zawarto wpisu jako sowa atomowe - odczyt w trakcie zapisu nie jest wycigiem danych
+    static constexpr int payloadWords = (int) ((sizeof(Payload) + sizeof(juce::uint64) - 1) / sizeof(juce::uint64));
+
+    struct Entry
+    {
+        std::atomic<juce::uint32> sequence{ 0 }; //nieparzyste - zapis w toku
+        std::atomic<juce::uint32> lastUsed{ 0 };
+        std::array<std::atomic<juce::uint64>, payloadWords> words{};
+    };
+
+    static constexpr int ways = 4;
+
+    static size_t hash(const Key& key);
+    Entry* getSet(const Key& key) { return entries.get() + (hash(key) & (size_t) (numSets - 1)) * ways; }
+    static bool read(const Entry& entry, Payload& payload);
+    static void write(Entry& entry, const Payload& payload);
+
+    int numSets{ 1 };
+    std::unique_ptr<Entry[]> entries;
+    juce::SpinLock writeLock;
+    std::atomic<juce::uint32> useClock{ 0 };
+    std::atomic<juce::uint64> hits{ 0 }, misses{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE(CoefficientCache)
+};
+
+//Wsplna pami projektw dla wszystkich instancji wtyczki w procesie (juce::SharedResourcePointer:
+//tworzona z pierwsz instancj, usuwana z ostatni). Instancje z tymi samymi ustawieniami przy tej
+//samej czstotliwoci dostaj sekcje zaprojektowane raz, odczyt bez blokad jak w CoefficientCache;
+//dwie instancje chybiajce jednoczenie mog zaprojektowa ten sam klucz dwa razy, wynik jest ten sam.
+//Wikszy budet ni dla jednej instancji - mieci ustawienia wielu rnych instancji.
+struct SharedCoefficientCache : CoefficientCache
+{
+    static constexpr size_t memoryBudgetBytes = 256 * 1024;
+    SharedCoefficientCache() : CoefficientCache(memoryBudgetBytes) {}
+};
@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+    DynamicBands.cpp
+
+  ==============================================================================
+*/
+
+#include "DynamicBands.h"
+
+void DynamicBands::prepare(double newSampleRate, int maxBlockSize, int newSubBlockSize)
+{
+    sampleRate = newSampleRate;
+    subBlockSize = juce::jmax(1, newSubBlockSize);
+
+    inputMono.assign((size_t) juce::jmax(1, maxBlockSize), 0.f);
+    sidechainMono.assign(inputMono.size(), 0.f);
+    gainChanges.assign((size_t) (((int) inputMono.size() + subBlockSize - 1) / subBlockSize * numBands), 0.f);
+
+    for (int index = 0; index < numBands; ++index)
+        updateDetector(index);
+
+    reset();
+}
+
+void DynamicBands::reset()
+{
+    for (auto& detector : detectors)
+    {
+        detector.s1 = Register::expand(0.f);
+        detector.s2 = Register::expand(0.f);
+        detector.envelope = Register::expand(0.f);
+    }
+
+    std::fill(gainChanges.begin(), gainChanges.end(), 0.f);
+    numSubBlocks = 0;
+    invalidate();
+}
+
+void DynamicBands::setBand(int index, const Band& band)
+{
+    auto& current = bands[(size_t) index];
+    const auto detectorChanged = band.frequency != current.frequency || band.quality != current.quality
+        || band.sidechain != current.sidechain || band.attack != current.attack || band.release != current.release;
+
+    //pasmo, ktre przestaje by dynamiczne, wraca do wspczynnikw statycznych przez invalidate w procesorze
+    numDynamic += (int) band.dynamic - (int) current.dynamic;
+    groupDynamic[(size_t) (index / lanes)] += (int) band.dynamic - (int) current.dynamic;
+    current = band;
+
+    if (detectorChanged)
+        updateDetector(index);
+}
+
+//pole rejestru pasma: filtr pasmowy o wzmocnieniu 0 dB w rodku pasma, stae czasowe obwiedni
+void DynamicBands::updateDetector(int index)
+{
+    const auto& band = bands[(size_t) index];
+    auto& detector = detectors[(size_t) (index / lanes)];
+    const auto lane = (size_t) (index % lanes);
+
+    const auto frequency = juce::jlimit(10.0, sampleRate * 0.45, (double) band.frequency);
+    const auto omega = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+    const auto alpha = std::sin(omega) / (2.0 * juce::jmax(0.1, (double) band.quality));
+    const auto a0 = 1.0 + alpha;
+
+    detector.b0.set(lane, (float) (alpha / a0));
+    detector.a1.set(lane, (float) (-2.0 * std::cos(omega) / a0));
+    detector.a2.set(lane, (float) ((1.0 - alpha) / a0));
+    detector.sidechain.set(lane, band.sidechain ? 1.f : 0.f);
+
+    //wspczynnik filtra jednobiegunowego dla staej czasowej w ms
+    auto coefficient = [this](float milliseconds)
+    {
+        return (float) (1.0 - std::exp(-1000.0 / (juce::jmax(0.01, (double) milliseconds) * sampleRate)));
+    };
+    detector.attack.set(lane, coefficient(band.attack));
+    detector.release.set(lane, coefficient(band.release));
+}
+
+void DynamicBands::runDetectors(int start, int numSamples)
+{
+    const auto zero = Register::expand(0.f);
+    const auto* input = inputMono.data() + start;
+    const auto* sidechain = sidechainMono.data() + start;
+
+    for (int group = 0; group < numGroups; ++group)
+    {
+        if (groupDynamic[(size_t) group] == 0)
+            continue;
+
+        auto& detector = detectors[(size_t) group];
+        auto s1 = detector.s1, s2 = detector.s2, envelope = detector.envelope;
+        const auto b0 = detector.b0, a1 = detector.a1, a2 = detector.a2;
+        const auto select = detector.sidechain, attack = detector.attack, release = detector.release;
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            //kade pasmo wybiera swoje rdo: wejcie + (sidechain - wejcie) * 0 albo 1
+            const auto inputSample = Register::expand(input[n]);
+            const auto x = inputSample + (Register::expand(sidechain[n]) - inputSample) * select;
+
+            const auto weighted = x * b0;
+            const auto y = weighted + s1;
+            s1 = s2 - y * a1;
+            s2 = zero - weighted - y * a2;
+
+            //prostowanie i obwiednia szczytowa, atak albo zwolnienie bez rozgazie
+            const auto level = Register::max(y, zero - y);
+            const auto coefficient = release + ((attack - release) & Register::greaterThan(level, envelope));
+            envelope += (level - envelope) * coefficient;
+        }
+
+        detector.s1 = s1;
+        detector.s2 = s2;
+        detector.envelope = envelope;
+    }
+
+    //obwiednia -> zmiana wzmocnienia (raz na podblok, skalarnie)
+    auto* changes = gainChanges.data() + numSubBlocks * numBands;
+    for (int index = 0; index < numBands; ++index)
+    {
+        const auto& band = bands[(size_t) index];
+        changes[index] = 0.f;
+        if (!band.dynamic)
+            continue;
+
+        const auto envelope = detectors[(size_t) (index / lanes)].envelope.get((size_t) (index % lanes));
+        const auto over = juce::Decibels::gainToDecibels(envelope, -100.f) - band.threshold;
+        if (over > 0.f)
+            changes[index] = juce::jmax(maxGainChange, -over * (1.f - 1.f / juce::jmax(1.f, band.ratio)));
+    }
+
+    ++numSubBlocks;
+}
+
+bool DynamicBands::designSection(int index, float gainChange, double processingSampleRate, SectionCoefficients& result)
+{
+    const auto& band = bands[(size_t) index];
+    auto& designed = lastDesigned[(size_t) index];
+    const auto gain = band.gain + gainChange;
+
+    if (designed.valid && designed.filterType == band.filterType && designed.frequency == band.frequency
+        && designed.quality == band.quality && designed.sampleRate == processingSampleRate
+        && std::abs(designed.gain - gain) < gainTolerance)
+        return false;
+
+    const auto gainFactor = juce::Decibels::decibelsToGain((double) gain);
+    switch (band.filterType)
+    {
+    case 1:
+        result = StaticFilterDesign::makeLowShelf(processingSampleRate, band.frequency, band.quality, gainFactor);
+        break;
+    case 2:
+        result = StaticFilterDesign::makeHighShelf(processingSampleRate, band.frequency, band.quality, gainFactor);
+        break;
+    default:
+        result = StaticFilterDesign::makePeakFilter(processingSampleRate, band.frequency, band.quality, gainFactor);
+        break;
+    }
+
+    designed = { true, band.filterType, band.frequency, band.quality, gain, processingSampleRate };
+    return true;
+}
@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+    DynamicBands.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "StaticFilterDesign.h"
+
+//dynamiczne pasma korektora: gdy poziom w detektorze pasma przekracza prg, wzmocnienie pasma jest
+//zmniejszane jak w kompresorze (prg, stosunek, atak, zwolnienie). Detektor to filtr pasmowy na
+//czstotliwoci i dobroci pasma, zasilany sum mono wejcia albo szyny sidechain.
+//Detektory pasm liczone s razem - pasmo to pole rejestru SIMD, wic filtr, prostowanie
+//i obwiednia czterech pasm kosztuj tyle co jeden detektor; grupy bez pasma dynamicznego s pomijane. Zmiana wzmocnienia wyznaczana jest raz
+//na podblok (ta sama siatka co przeliczanie wspczynnikw kaskady), a wspczynniki pasma projektowane
+//s od nowa tylko wtedy, gdy zmiana jest syszalna.
+class DynamicBands
+{
+public:
+    using Register = juce::dsp::SIMDRegister<float>;
+    static constexpr int numBands = 24;
+    static constexpr int lanes = (int) Register::SIMDNumElements;
+    static constexpr int numGroups = (numBands + lanes - 1) / lanes;
+
+    //najwiksze tumienie pasma w dB
+    static constexpr float maxGainChange = -24.f;
+    //mniejsza rnica wzmocnienia nie zmienia wspczynnikw
+    static constexpr float gainTolerance = 0.05f;
+
+    //ustawienia pasma odczytane z parametrw na pocztku bloku
+    struct Band
+    {
+        bool dynamic{ false }, sidechain{ false };
+        //dB, n:1, ms, ms
+        float threshold{ -20.f }, ratio{ 2.f }, attack{ 10.f }, release{ 100.f };
+        //pasmo korektora: filterType jak w parametrze FilterN Type, gain w dB
+        int filterType{ 0 };
+        float frequency{ 1000.f }, quality{ 1.f }, gain{ 0.f };
+    };
+
+    void prepare(double sampleRate, int maxBlockSize, int subBlockSize);
+    void reset();
+
+    //wtek audio, przed analyse
+    void setBand(int index, const Band& band);
+    bool isActive() const { return numDynamic > 0; }
+    bool isDynamic(int index) const { return bands[(size_t) index].dynamic; }
+
+    //detektory na bloku wejciowym (czstotliwo hosta); sidechain == nullptr - szyna wyczona
+    template<typename SampleType>
+    void analyse(const juce::dsp::AudioBlock<SampleType>& input, const juce::dsp::AudioBlock<SampleType>* sidechain);
+
+    //zmiana wzmocnienia pasma (dB, <= 0) w podbloku ostatniego analyse
+    float getGainChange(int subBlock, int index) const
+    {
+        return gainChanges[(size_t) (juce::jlimit(0, juce::jmax(0, numSubBlocks - 1), subBlock) * numBands + index)];
+    }
+
+    //wspczynniki pasma ze zmian wzmocnienia; false, gdy nie rni si od ostatnio zwrconych
+    bool designSection(int index, float gainChange, double processingSampleRate, SectionCoefficients& result);
+    //sekcja pasma zostaa nadpisana (np. statycznymi wspczynnikami) - nastpny designSection j odtworzy
+    void invalidate() { for (auto& designed : lastDesigned) designed.valid = false; }
+
+    //pami buforw przydzielonych w prepare (bez samego obiektu)
+    size_t getMemoryBytes() const
+    {
+        return (inputMono.capacity() + sidechainMono.capacity() + gainChanges.capacity()) * sizeof(float);
+    }
+
+private:
+    template<typename SampleType>
+    static void downmix(const juce::dsp::AudioBlock<SampleType>& block, float* destination, int numSamples);
+    void runDetectors(int start, int numSamples);
+    void updateDetector(int index);
+
+    struct Detector
+    {
+        //filtr pasmowy RBJ (b1 = 0, b2 = -b0), stan w postaci transponowanej II
+        Register b0, a1, a2, s1, s2;
+        //1 - pasmo sucha sidechain, 0 - wejcia
+        Register sidechain;
+        Register attack, release, envelope;
+    };
+
+    //ostatnio zaprojektowane pasmo
+    struct Designed
+    {
+        bool valid{ false };
+        int filterType{ 0 };
+        float frequency{ 0 }, quality{ 0 }, gain{ 0 };
+        double sampleRate{ 0 };
+    };
+
+    double sampleRate{ 44100.0 };
+    int subBlockSize{ 32 };
+
+    std::array<Band, numBands> bands;
+    std::array<Detector, numGroups> detectors;
+    //liczba pasm dynamicznych w grupie detektorw
+    std::array<int, numGroups> groupDynamic{};
+    std::array<Designed, numBands> lastDesigned;
+    int numDynamic{ 0 };
+
+    std::vector<float> inputMono, sidechainMono;
+    std::vector<float> gainChanges;
+    int numSubBlocks{ 0 };
+};
+
+template<typename SampleType>
+void DynamicBands::downmix(const juce::dsp::AudioBlock<SampleType>& block, float* destination, int numSamples)
+{
+    const auto numChannels = (int) block.getNumChannels();
+    const auto scale = 1.f / (float) juce::jmax(1, numChannels);
+
+    std::fill(destination, destination + numSamples, 0.f);
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        const auto* samples = block.getChannelPointer((size_t) channel);
+        for (int i = 0; i < numSamples; ++i)
+            destination[i] += (float) samples[i] * scale;
+    }
+}
+
+template<typename SampleType>
+void DynamicBands::analyse(const juce::dsp::AudioBlock<SampleType>& input, const juce::dsp::AudioBlock<SampleType>* sidechain)
+{
+    numSubBlocks = 0;
+    if (numDynamic == 0)
+        return;
+
+    //blok duszy ni w prepare - reszta bloku dostaje zmian z ostatniego podbloku
+    const auto numSamples = juce::jmin((int) input.getNumSamples(), (int) inputMono.size());
+
+    downmix(input, inputMono.data(), numSamples);
+    if (sidechain != nullptr)
+        downmix(*sidechain, sidechainMono.data(), numSamples);
+    else
+        std::copy(inputMono.begin(), inputMono.begin() + numSamples, sidechainMono.begin());
+
+    for (int start = 0; start < numSamples; start += subBlockSize)
+        runDetectors(start, juce::jmin(subBlockSize, numSamples - start));
+}
@@ -0,0 +1,260 @@
+/*
+  ==============================================================================
+
+    LinearPhase.cpp
+
+  ==============================================================================
+*/
+
+#include "LinearPhase.h"
+
+//|H(e^jw)| jednej sekcji biquad
+static double getMagnitude(const SectionCoefficients& c, double omega)
+{
+    const auto z1 = std::polar(1.0, -omega);
+    const auto z2 = z1 * z1;
+    const auto numerator = (double) c.b0 + (double) c.b1 * z1 + (double) c.b2 * z2;
+    const auto denominator = 1.0 + (double) c.a1 * z1 + (double) c.a2 * z2;
+    return std::abs(numerator / denominator);
+}
+
+LinearPhaseConvolver::LinearPhaseConvolver()
+    : juce::Thread("Linear Phase Kernel")
+{
+}
+
+LinearPhaseConvolver::~LinearPhaseConvolver()
+{
+    stopThread(1000);
+}
+
+void LinearPhaseConvolver::prepare(double newSampleRate, int newNumChannels, const ChainCoefficients& coefficients, double designSampleRate)
+{
+    stopThread(1000);
+
+    sampleRate = newSampleRate;
+    numChannels = newNumChannels;
+
+    //FIR ok. 170 ms - rozdzielczo wystarczajca dla HP przy 20 Hz; nieparzysta dugo,
+    //eby FIR by symetryczny wzgldem rodkowej prbki
+    kernelOrder = juce::jlimit(12, 16, (int) std::ceil(std::log2(sampleRate * 0.17)));
+    kernelLength = (1 << kernelOrder) - 1;
+    numPartitions = (kernelLength + partitionSize - 1) / partitionSize;
+
+    kernelFFT = std::make_unique<juce::dsp::FFT>(kernelOrder);
+    window = std::make_unique<juce::dsp::WindowingFunction<float>>((size_t) kernelLength,
+        juce::dsp::WindowingFunction<float>::blackman, false);
+    kernelBuffer.assign((size_t) (2 << kernelOrder), 0.f);
+    firBuffer.assign((size_t) kernelLength, 0.f);
+
+    requests.reset({});
+    kernels.reset(std::vector<std::complex<float>>((size_t) (numPartitions * numBins)));
+
+    inputFifo.setSize(numChannels, partitionSize);
+    outputFifo.setSize(numChannels, partitionSize);
+    previousInput.setSize(numChannels, partitionSize);
+    crossfadeBuffer.setSize(1, partitionSize);
+    inputFifo.clear();
+    outputFifo.clear();
+    previousInput.clear();
+
+    spectraDelayLine.assign((size_t) numChannels, std::vector<std::complex<float>>((size_t) (numPartitions * numBins)));
+    accumulator.assign((size_t) numBins, {});
+    fftBuffer.assign((size_t) (4 * partitionSize), 0.f);
+    fifoPosition = 0;
+    delayLineHead = 0;
+
+    buildKernel({ coefficients, designSampleRate }, kernels.getWriteBuffer());
+    kernels.publish();
+    kernels.acquire();
+
+    startThread();
+}
+
+void LinearPhaseConvolver::setCoefficients(const ChainCoefficients& coefficients, double designSampleRate)
+{
+    auto& request = requests.getWriteBuffer();
+    request.coefficients = coefficients;
+    request.designSampleRate = designSampleRate;
+    requests.publish();
+}
+
+//notify() blokuje muteks zdarzenia, wic wtek audio go nie woa - zlecenie czeka w buforze
+//potrjnym najwyej buildIntervalMs (stopThread budzi wtek od razu)
+void LinearPhaseConvolver::run()
+{
+    while (!threadShouldExit())
+    {
+        if (requests.acquire())
+        {
+            buildKernel(requests.getReadBuffer(), kernels.getWriteBuffer());
+            kernels.publish();
+        }
+
+        wait(buildIntervalMs);
+    }
+}
+
+void LinearPhaseConvolver::buildKernel(const KernelRequest& request, std::vector<std::complex<float>>& spectra)
+{
+    const auto fftSize = 1 << kernelOrder;
+    std::fill(kernelBuffer.begin(), kernelBuffer.end(), 0.f);
+
+    //charakterystyka amplitudowa kaskady na siatce FFT, faza zerowa
+    for (int k = 0; k <= fftSize / 2; ++k)
+    {
+        const auto omega = juce::MathConstants<double>::twoPi * (k * sampleRate / fftSize) / request.designSampleRate;
+
+        double magnitude = 1.0;
+        for (int i = 0; i < ChainCoefficients::numSections; ++i)
+            if (request.coefficients.isActive(i))
+                magnitude *= getMagnitude(request.coefficients.getSection(i), omega);
+
+        kernelBuffer[(size_t) (2 * k)] = (float) magnitude;
+    }
+
+    kernelFFT->performRealOnlyInverseTransform(kernelBuffer.data());
+
+    //odpowied o fazie zerowej jest parzysta - przesunicie do rodka FIR i okno
+    const auto centre = (kernelLength - 1) / 2;
+    for (int n = 0; n < kernelLength; ++n)
+        firBuffer[(size_t) n] = kernelBuffer[(size_t) ((n - centre + fftSize) % fftSize)];
+
+    window->multiplyWithWindowingTable(firBuffer.data(), (size_t) kernelLength);
+
+    //widma kolejnych partycji
+    for (int p = 0; p < numPartitions; ++p)
+    {
+        std::fill(kernelBuffer.begin(), kernelBuffer.begin() + 4 * partitionSize, 0.f);
+
+        const auto start = p * partitionSize;
+        const auto count = juce::jmin(partitionSize, kernelLength - start);
+        std::copy(firBuffer.begin() + start, firBuffer.begin() + start + count, kernelBuffer.begin());
+
+        kernelPartitionFFT.performRealOnlyForwardTransform(kernelBuffer.data(), true);
+
+        const auto* bins = reinterpret_cast<const std::complex<float>*>(kernelBuffer.data());
+        std::copy(bins, bins + numBins, spectra.begin() + p * numBins);
+    }
+}
+
+void LinearPhaseConvolver::process(const juce::dsp::AudioBlock<float>& block)
+{
+    const auto numSamples = (int) block.getNumSamples();
+    const auto channels = juce::jmin(numChannels, (int) block.getNumChannels());
+
+    for (int offset = 0; offset < numSamples;)
+    {
+        const auto count = juce::jmin(numSamples - offset, partitionSize - fifoPosition);
+
+        for (int channel = 0; channel < channels; ++channel)
+        {
+            auto* data = block.getChannelPointer((size_t) channel) + offset;
+            const auto* output = outputFifo.getReadPointer(channel, fifoPosition);
+
+            std::copy(data, data + count, inputFifo.getWritePointer(channel, fifoPosition));
+            std::copy(output, output + count, data);
+        }
+
+        fifoPosition += count;
+        offset += count;
+
+        if (fifoPosition == partitionSize)
+        {
+            processPartition();
+            fifoPosition = 0;
+        }
+    }
+}
+
+void LinearPhaseConvolver::reset()
+{
+    inputFifo.clear();
+    outputFifo.clear();
+    previousInput.clear();
+    for (auto& spectra : spectraDelayLine)
+        std::fill(spectra.begin(), spectra.end(), std::complex<float>());
+}
+
+size_t LinearPhaseConvolver::getMemoryBytes() const
+{
+    auto bufferBytes = [](const juce::AudioBuffer<float>& buffer)
+    {
+        return (size_t) buffer.getNumChannels() * (size_t) buffer.getNumSamples() * sizeof(float);
+    };
+
+    //trzy komplety widm kernela w buforze potrjnym
+    auto bytes = 3 * kernels.getReadBuffer().capacity() * sizeof(std::complex<float>)
+               + (kernelBuffer.capacity() + firBuffer.capacity() + fftBuffer.capacity()) * sizeof(float)
+               + accumulator.capacity() * sizeof(std::complex<float>)
+               + bufferBytes(inputFifo) + bufferBytes(outputFifo) + bufferBytes(previousInput) + bufferBytes(crossfadeBuffer);
+
+    for (auto& spectra : spectraDelayLine)
+        bytes += spectra.capacity() * sizeof(std::complex<float>);
+
+    return bytes;
+}
+
+void LinearPhaseConvolver::processPartition()
+{
+    delayLineHead = (delayLineHead + numPartitions - 1) % numPartitions;
+
+    //nowy kernel: wynik liczony starym i nowym, potem przenikanie przez jedn partycj
+    const bool swapKernel = kernels.hasNewData();
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        //overlap-save: [poprzednia partycja | bieca partycja] -> widmo na pocztek linii opniajcej
+        std::copy(previousInput.getReadPointer(channel), previousInput.getReadPointer(channel) + partitionSize, fftBuffer.begin());
+        std::copy(inputFifo.getReadPointer(channel), inputFifo.getReadPointer(channel) + partitionSize, fftBuffer.begin() + partitionSize);
+        std::fill(fftBuffer.begin() + 2 * partitionSize, fftBuffer.end(), 0.f);
+        previousInput.copyFrom(channel, 0, inputFifo, channel, 0, partitionSize);
+
+        partitionFFT.performRealOnlyForwardTransform(fftBuffer.data(), true);
+
+        const auto* bins = reinterpret_cast<const std::complex<float>*>(fftBuffer.data());
+        std::copy(bins, bins + numBins, spectraDelayLine[(size_t) channel].begin() + delayLineHead * numBins);
+
+        convolve(kernels.getReadBuffer(), channel, outputFifo.getWritePointer(channel));
+    }
+
+    if (swapKernel && kernels.acquire())
+    {
+        auto* faded = crossfadeBuffer.getWritePointer(0);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto* output = outputFifo.getWritePointer(channel);
+            convolve(kernels.getReadBuffer(), channel, faded);
+
+            for (int i = 0; i < partitionSize; ++i)
+            {
+                const auto t = (float) (i + 1) / (float) partitionSize;
+                output[i] += t * (faded[i] - output[i]);
+            }
+        }
+    }
+}
+
+void LinearPhaseConvolver::convolve(const std::vector<std::complex<float>>& spectra, int channel, float* output)
+{
+    std::fill(accumulator.begin(), accumulator.end(), std::complex<float>());
+    const auto& delayLine = spectraDelayLine[(size_t) channel];
+
+    //suma iloczynw widm: partycja p kernela z wejciem sprzed p partycji
+    for (int p = 0; p < numPartitions; ++p)
+    {
+        const auto* x = delayLine.data() + ((delayLineHead + p) % numPartitions) * numBins;
+        const auto* h = spectra.data() + p * numBins;
+
+        for (int k = 0; k < numBins; ++k)
+            accumulator[(size_t) k] += std::complex<float>(x[k].real() * h[k].real() - x[k].imag() * h[k].imag(),
+                                                           x[k].real() * h[k].imag() + x[k].imag() * h[k].real());
+    }
+
+    std::copy(accumulator.begin(), accumulator.end(), reinterpret_cast<std::complex<float>*>(fftBuffer.data()));
+    partitionFFT.performRealOnlyInverseTransform(fftBuffer.data());
+
+    //overlap-save: poprawna jest tylko druga poowa wyniku
+    std::copy(fftBuffer.begin() + partitionSize, fftBuffer.begin() + 2 * partitionSize, output);
+}
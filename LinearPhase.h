@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    LinearPhase.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+//tryb liniowej fazy: symetryczny FIR o tej samej charakterystyce amplitudowej co kaskada
+//(HP, pasma, LP), splatany metod overlap-save z jednakowym podziaem na partycje.
+//Kernel jest liczony w osobnym wtku, a nowy kernel wchodzi z przenikaniem przez jedn partycj.
+class LinearPhaseConvolver : private juce::Thread
+{
+public:
+    LinearPhaseConvolver();
+    ~LinearPhaseConvolver() override;
+
+    //alokacja buforw i pierwszy kernel liczony od razu
+    void prepare(double sampleRate, int numChannels, const ChainCoefficients& coefficients, double designSampleRate);
+
+    //opnienie: bufor wejciowy (jedna partycja) + poowa dugoci FIR
+    int getLatencySamples() const { return partitionSize + (kernelLength - 1) / 2; }
+
+    //wtek audio - zlecenie przeliczenia kernela przez bufor potrjny, bez alokacji i bez blokad
+    //(wtek kernela nie jest budzony, sam sprawdza zlecenia co buildIntervalMs)
+    void setCoefficients(const ChainCoefficients& coefficients, double designSampleRate);
+    void process(const juce::dsp::AudioBlock<float>& block);
+    //wtek audio - czyci wejcie, wyjcie i lini opniajc (cisza na wejciu), bez alokacji
+    void reset();
+
+    //pami buforw i kerneli (bez samego obiektu i wewntrznych tablic FFT)
+    size_t getMemoryBytes() const;
+
+private:
+    struct KernelRequest
+    {
+        ChainCoefficients coefficients;
+        double designSampleRate{ 0 };
+    };
+
+    void run() override;
+    //charakterystyka -> FIR -> widma partycji
+    void buildKernel(const KernelRequest& request, std::vector<std::complex<float>>& spectra);
+    //splot jednej partycji dla wszystkich kanaw
+    void processPartition();
+    void convolve(const std::vector<std::complex<float>>& spectra, int channel, float* output);
+
+    //partycja 512 prbek, FFT o rozmiarze 1024
+    static constexpr int fftOrder = 10;
+    static constexpr int partitionSize = 1 << (fftOrder - 1);
+    static constexpr int numBins = partitionSize + 1;
+    static constexpr int buildIntervalMs = 5;
+
+    double sampleRate{ 0 };
+    int numChannels{ 0 }, kernelOrder{ 0 }, kernelLength{ 0 }, numPartitions{ 0 };
+
+    //osobne FFT dla wtku audio i wtku liczcego kernel (FFT ma wewntrzn blokad)
+    juce::dsp::FFT partitionFFT{ fftOrder }, kernelPartitionFFT{ fftOrder };
+    std::unique_ptr<juce::dsp::FFT> kernelFFT;
+    std::unique_ptr<juce::dsp::WindowingFunction<float>> window;
+    std::vector<float> kernelBuffer, firBuffer;
+
+    TripleBuffer<KernelRequest> requests;
+    TripleBuffer<std::vector<std::complex<float>>> kernels;
+
+    //bufory wtku audio, na kana: wejcie, wyjcie, poprzednia partycja, linia opniajca widm
+    juce::AudioBuffer<float> inputFifo, outputFifo, previousInput, crossfadeBuffer;
+    std::vector<std::vector<std::complex<float>>> spectraDelayLine;
+    std::vector<std::complex<float>> accumulator;
+    std::vector<float> fftBuffer;
+    int fifoPosition{ 0 }, delayLineHead{ 0 };
+};
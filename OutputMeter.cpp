@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+    OutputMeter.cpp
+
+  ==============================================================================
+*/
+
+#include "OutputMeter.h"
+
+//ITU-R BS.1770-4, aneks 2: 48 wspczynnikw, 4 fazy po 12
+const float OutputMeter::truePeakCoefficients[truePeakPhases][truePeakTaps]
+{
+    {  0.0017089843750f,  0.0109863281250f, -0.0196533203125f,  0.0332031250000f, -0.0594482421875f,  0.1373291015625f,
+       0.9721679687500f, -0.1022949218750f,  0.0476074218750f, -0.0266113281250f,  0.0148925781250f, -0.0083007812500f },
+    { -0.0291748046875f,  0.0292968750000f, -0.0517578125000f,  0.0891113281250f, -0.1665039062500f,  0.4650878906250f,
+       0.7797851562500f, -0.2003173828125f,  0.1015625000000f, -0.0582275390625f,  0.0330810546875f, -0.0189208984375f },
+    { -0.0189208984375f,  0.0330810546875f, -0.0582275390625f,  0.1015625000000f, -0.2003173828125f,  0.7797851562500f,
+       0.4650878906250f, -0.1665039062500f,  0.0891113281250f, -0.0517578125000f,  0.0292968750000f, -0.0291748046875f },
+    { -0.0083007812500f,  0.0148925781250f, -0.0266113281250f,  0.0476074218750f, -0.1022949218750f,  0.9721679687500f,
+       0.1373291015625f, -0.0594482421875f,  0.0332031250000f, -0.0196533203125f,  0.0109863281250f,  0.0017089843750f }
+};
+
+OutputMeter::OutputMeter()
+{
+    for (int channel = 0; channel < maxChannels; ++channel)
+    {
+        rmsLevels[(size_t) channel] = silenceDecibels;
+        peakLevels[(size_t) channel] = silenceDecibels;
+        truePeakLevels[(size_t) channel] = silenceDecibels;
+    }
+}
+
+void OutputMeter::prepare(double sampleRate, int newNumChannels, int maxBlockSize)
+{
+    numChannels = juce::jlimit(0, maxChannels, newNumChannels);
+    gains.assign((size_t) juce::jmax(1, maxBlockSize), 1.f);
+
+    gain.reset(sampleRate, 0.01);
+    gain.setCurrentAndTargetValue(gain.getTargetValue());
+
+    //filtr K z BS.1770 przeliczony dla biecej czstotliwoci (wzory jak w libebur128)
+    {
+        const auto frequency = 1681.974450955533, gainDecibels = 3.999843853973347, quality = 0.7071752369554196;
+        const auto K = std::tan(juce::MathConstants<double>::pi * frequency / sampleRate);
+        const auto Vh = std::pow(10.0, gainDecibels / 20.0);
+        const auto Vb = std::pow(Vh, 0.4996667741545416);
+        const auto a0 = 1.0 + K / quality + K * K;
+
+        shelf = { (Vh + Vb * K / quality + K * K) / a0, 2.0 * (K * K - Vh) / a0, (Vh - Vb * K / quality + K * K) / a0,
+                  2.0 * (K * K - 1.0) / a0, (1.0 - K / quality + K * K) / a0 };
+    }
+    {
+        const auto frequency = 38.13547087602444, quality = 0.5003270373238773;
+        const auto K = std::tan(juce::MathConstants<double>::pi * frequency / sampleRate);
+        const auto a0 = 1.0 + K / quality + K * K;
+
+        highPass = { 1.0, -2.0, 1.0, 2.0 * (K * K - 1.0) / a0, (1.0 - K / quality + K * K) / a0 };
+    }
+
+    for (auto& channel : channels)
+    {
+        channel.weighting = {};
+        channel.history = {};
+        channel.historyIndex = 0;
+        channel.truePeak = 0;
+
+        channel.rms.reset(sampleRate, 0.4);
+        channel.rms.setCurrentAndTargetValue(silenceDecibels);
+        channel.peak.reset(sampleRate, 1.0);
+        channel.peak.setCurrentAndTargetValue(silenceDecibels);
+    }
+
+    stepSize = juce::jmax(1, juce::roundToInt(sampleRate * 0.1));
+    stepPosition = 0;
+    stepEnergy = 0;
+    stepEnergies = {};
+    stepIndex = 0;
+    numSteps = 0;
+
+    for (int channel = 0; channel < maxChannels; ++channel)
+    {
+        rmsLevels[(size_t) channel].store(silenceDecibels, std::memory_order_relaxed);
+        peakLevels[(size_t) channel].store(silenceDecibels, std::memory_order_relaxed);
+        truePeakLevels[(size_t) channel].store(silenceDecibels, std::memory_order_relaxed);
+    }
+    momentaryLoudness.store(silenceDecibels, std::memory_order_relaxed);
+    shortTermLoudness.store(silenceDecibels, std::memory_order_relaxed);
+}
+
+void OutputMeter::processSilence(int numSamples)
+{
+    for (auto& channel : channels)
+    {
+        channel.weighting = {};
+        channel.history = {};
+        if (truePeakResetRequested.load(std::memory_order_relaxed))
+            channel.truePeak = 0;
+    }
+    truePeakResetRequested.store(false, std::memory_order_relaxed);
+
+    gain.skip(numSamples);
+
+    for (int remaining = numSamples; remaining > 0;)
+    {
+        const auto length = juce::jmin(remaining, stepSize - stepPosition);
+        remaining -= length;
+        stepPosition += length;
+        if (stepPosition == stepSize)
+            finishLoudnessStep();
+    }
+
+    const std::array<double, maxChannels> sumSquares{};
+    const std::array<float, maxChannels> peaks{};
+    publish(numChannels, numSamples, sumSquares.data(), peaks.data());
+}
+
+//gono z ostatnich 400 ms i 3 s, przeliczana co krok 100 ms
+void OutputMeter::finishLoudnessStep()
+{
+    stepEnergies[(size_t) stepIndex] = stepEnergy / (double) stepSize;
+    stepIndex = (stepIndex + 1) % loudnessSteps;
+    numSteps = juce::jmin(numSteps + 1, loudnessSteps);
+    stepEnergy = 0;
+    stepPosition = 0;
+
+    auto loudness = [&](int count)
+    {
+        count = juce::jmin(count, numSteps);
+
+        double sum = 0;
+        for (int step = 1; step <= count; ++step)
+            sum += stepEnergies[(size_t) ((stepIndex - step + loudnessSteps) % loudnessSteps)];
+
+        return juce::jmax(silenceDecibels, (float) (-0.691 + 10.0 * std::log10(juce::jmax(sum / count, 1.0e-20))));
+    };
+
+    momentaryLoudness.store(loudness(momentarySteps), std::memory_order_relaxed);
+    shortTermLoudness.store(loudness(loudnessSteps), std::memory_order_relaxed);
+}
+
+//wskazania opadaj w czasie ramp rms i peak, wzrost pokazywany od razu
+void OutputMeter::publish(int numMetered, int numSamples, const double* sumSquares, const float* peaks)
+{
+    auto follow = [numSamples](juce::LinearSmoothedValue<float>& meter, float level)
+    {
+        meter.skip(numSamples);
+        if (level < meter.getCurrentValue())
+            meter.setTargetValue(level);
+        else
+            meter.setCurrentAndTargetValue(level);
+        return meter.getCurrentValue();
+    };
+
+    for (int channel = 0; channel < numMetered; ++channel)
+    {
+        auto& state = channels[(size_t) channel];
+        const auto rms = (float) std::sqrt(sumSquares[channel] / juce::jmax(1, numSamples));
+
+        rmsLevels[(size_t) channel].store(follow(state.rms, juce::Decibels::gainToDecibels(rms, silenceDecibels)), std::memory_order_relaxed);
+        peakLevels[(size_t) channel].store(follow(state.peak, juce::Decibels::gainToDecibels(peaks[channel], silenceDecibels)), std::memory_order_relaxed);
+        truePeakLevels[(size_t) channel].store(juce::Decibels::gainToDecibels(state.truePeak, silenceDecibels), std::memory_order_relaxed);
+    }
+}
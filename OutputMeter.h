@@ -0,0 +1,188 @@
+/*
+  ==============================================================================
+
+    OutputMeter.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BiquadCascade.h"
+
+//wzmocnienie kocowe i mierniki wyjcia w jednym przejciu po buforze: szczyt, RMS,
+//szczyt rzeczywisty (nadprbkowanie 4x filtrem z ITU-R BS.1770-4, aneks 2) oraz gono
+//EBU R128 momentary (400 ms) i short-term (3 s) z filtra K, w krokach co 100 ms.
+//Stan liczony tylko w wtku audio, wyniki publikowane przez atomiki - odczyt z dowolnego wtku.
+//Wszystkie kanay maj wag 1 (BS.1770 daje 1.41 kanaom surround, ukad kanaw nie jest tu znany).
+class OutputMeter
+{
+public:
+    static constexpr int maxChannels = 16;
+    static constexpr float silenceDecibels = -100.f;
+
+    OutputMeter();
+
+    void prepare(double sampleRate, int numChannels, int maxBlockSize);
+
+    //wzmocnienie z ramp 10 ms, jak wczeniej w juce::dsp::Gain
+    void setGainDecibels(float decibels) { gain.setTargetValue(juce::Decibels::decibelsToGain(decibels)); }
+
+    //tylko wtek audio: wzmocnienie w miejscu i pomiar wyniku
+    template<typename SampleType>
+    void process(const juce::dsp::AudioBlock<SampleType>& block);
+    //blok ciszy (wyzerowany przez procesor) bez przejcia po prbkach: stan filtrw zerowany,
+    //wskazania opadaj, kroki gonoci dostaj zerow energi
+    void processSilence(int numSamples);
+
+    //dowolny wtek; dBFS, gono w LUFS
+    float getRMS(int channel) const { return load(rmsLevels, channel); }
+    float getPeak(int channel) const { return load(peakLevels, channel); }
+    //najwikszy szczyt rzeczywisty od prepare lub resetTruePeak
+    float getTruePeak(int channel) const { return load(truePeakLevels, channel); }
+    float getMomentaryLoudness() const { return momentaryLoudness.load(std::memory_order_relaxed); }
+    float getShortTermLoudness() const { return shortTermLoudness.load(std::memory_order_relaxed); }
+
+    //dowolny wtek, maksimum zerowane przez wtek audio w nastpnym bloku
+    void resetTruePeak() { truePeakResetRequested.store(true, std::memory_order_relaxed); }
+
+private:
+    static constexpr int truePeakTaps = 12, truePeakPhases = 4;
+    static const float truePeakCoefficients[truePeakPhases][truePeakTaps];
+
+    static constexpr int loudnessSteps = 30; //3 s po 100 ms
+    static constexpr int momentarySteps = 4; //400 ms
+
+    struct ChannelState
+    {
+        //filtr K: pka + grnoprzepustowy 38 Hz, stan w double (bieguny blisko z = 1)
+        std::array<double, 4> weighting{};
+        //ostatnie prbki dla interpolatora zapisane dwa razy - okno filtra zawsze cige
+        std::array<float, 2 * truePeakTaps> history{};
+        int historyIndex{ 0 };
+        float truePeak{ 0 };
+        //opadanie wskaza po spadku poziomu
+        juce::LinearSmoothedValue<float> rms, peak;
+    };
+
+    template<typename SampleType>
+    double processChannel(SampleType* samples, int numSamples, ChannelState& state, double& sumSquares, float& peak);
+    void finishLoudnessStep();
+    void publish(int numChannels, int numSamples, const double* sumSquares, const float* peaks);
+
+    static float load(const std::array<std::atomic<float>, maxChannels>& levels, int channel)
+    {
+        return juce::isPositiveAndBelow(channel, maxChannels) ? levels[(size_t) channel].load(std::memory_order_relaxed) : silenceDecibels;
+    }
+
+    juce::LinearSmoothedValue<float> gain{ 1.f };
+    std::vector<float> gains;
+
+    SectionCoefficients shelf, highPass;
+    std::array<ChannelState, maxChannels> channels;
+    int numChannels{ 0 };
+
+    //gono: redni kwadrat (suma kanaw) kolejnych krokw 100 ms
+    int stepSize{ 1 }, stepPosition{ 0 };
+    double stepEnergy{ 0 };
+    std::array<double, loudnessSteps> stepEnergies{};
+    int stepIndex{ 0 }, numSteps{ 0 };
+
+    std::array<std::atomic<float>, maxChannels> rmsLevels, peakLevels, truePeakLevels;
+    std::atomic<float> momentaryLoudness{ silenceDecibels }, shortTermLoudness{ silenceDecibels };
+    std::atomic<bool> truePeakResetRequested{ false };
+};
+
+template<typename SampleType>
+void OutputMeter::process(const juce::dsp::AudioBlock<SampleType>& block)
+{
+    const auto numSamples = (int) block.getNumSamples();
+    const auto numMetered = juce::jmin((int) block.getNumChannels(), numChannels);
+
+    if (truePeakResetRequested.exchange(false, std::memory_order_relaxed))
+        for (auto& channel : channels)
+            channel.truePeak = 0;
+
+    std::array<double, maxChannels> sumSquares{};
+    std::array<float, maxChannels> peaks{};
+
+    //odcinki kocz si na granicy kroku gonoci albo po gains.size() prbkach
+    for (int start = 0; start < numSamples;)
+    {
+        const auto length = juce::jmin(numSamples - start, stepSize - stepPosition, (int) gains.size());
+
+        if (gain.isSmoothing())
+            for (int i = 0; i < length; ++i)
+                gains[(size_t) i] = gain.getNextValue();
+        else
+            std::fill(gains.begin(), gains.begin() + length, gain.getTargetValue());
+
+        for (int channel = 0; channel < numMetered; ++channel)
+            stepEnergy += processChannel(block.getChannelPointer((size_t) channel) + start, length,
+                                         channels[(size_t) channel], sumSquares[(size_t) channel], peaks[(size_t) channel]);
+
+        //kanay ponad maxChannels - tylko wzmocnienie
+        for (int channel = numMetered; channel < (int) block.getNumChannels(); ++channel)
+        {
+            auto* samples = block.getChannelPointer((size_t) channel) + start;
+            for (int i = 0; i < length; ++i)
+                samples[i] *= (SampleType) gains[(size_t) i];
+        }
+
+        start += length;
+        stepPosition += length;
+        if (stepPosition == stepSize)
+            finishLoudnessStep();
+    }
+
+    publish(numMetered, numSamples, sumSquares.data(), peaks.data());
+}
+
+//zwraca energi po filtrze K
+template<typename SampleType>
+double OutputMeter::processChannel(SampleType* samples, int numSamples, ChannelState& state, double& sumSquares, float& peak)
+{
+    auto s = state.weighting;
+    auto* history = state.history.data();
+    auto index = state.historyIndex;
+    auto truePeak = state.truePeak;
+    double energy = 0;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto output = samples[i] * (SampleType) gains[(size_t) i];
+        samples[i] = output;
+
+        const auto value = (double) output;
+        sumSquares += value * value;
+        peak = juce::jmax(peak, std::abs((float) output));
+
+        //filtr K, posta transponowana II
+        const auto shelved = shelf.b0 * value + s[0];
+        s[0] = shelf.b1 * value - shelf.a1 * shelved + s[1];
+        s[1] = shelf.b2 * value - shelf.a2 * shelved;
+        const auto weighted = highPass.b0 * shelved + s[2];
+        s[2] = highPass.b1 * shelved - highPass.a1 * weighted + s[3];
+        s[3] = highPass.b2 * shelved - highPass.a2 * weighted;
+        energy += weighted * weighted;
+
+        //szczyt rzeczywisty: 4 fazy interpolatora na ostatnich truePeakTaps prbkach
+        history[index] = history[index + truePeakTaps] = (float) output;
+        index = index + 1 == truePeakTaps ? 0 : index + 1;
+        const auto* window = history + index;
+
+        for (int phase = 0; phase < truePeakPhases; ++phase)
+        {
+            float interpolated = 0;
+            for (int tap = 0; tap < truePeakTaps; ++tap)
+                interpolated += truePeakCoefficients[phase][tap] * window[truePeakTaps - 1 - tap];
+            truePeak = juce::jmax(truePeak, std::abs(interpolated));
+        }
+    }
+
+    state.weighting = s;
+    state.historyIndex = index;
+    state.truePeak = truePeak;
+    return energy;
+}
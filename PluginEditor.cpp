@@ -49,7 +49,11 @@ void LookAndFeel::drawRotarySlider(juce::Graphics& g,
         juce::String text;
 
         //napisy przed stringami
-        if (knob->getUnit() == "Hz")
+        if (knob->getLabel().isNotEmpty())
+        {
+            text << knob->getLabel() << ": ";
+        }
+        else if (knob->getUnit() == "Hz")
         {
             text << "f: ";
         }
@@ -115,6 +119,15 @@ juce::String KnobWithText::getString() const
         {
             s = juce::String(value, 2);
         }
+        else if (unit == "ms")
+        {
+            s = juce::String(value, 1);
+            s << " ";
+        }
+        else if (unit == ":1")
+        {
+            s = juce::String(value, 1);
+        }
         else if (value < 1000.f)
         {
             s = juce::String(value, 0);
@@ -157,6 +170,13 @@ void KnobWithText::paint(juce::Graphics& g)
 }
 
 
+//pozycje listy z parametru wyboru - attachment podczany dopiero do wypenionej listy
+static void addChoices(juce::ComboBox& box, juce::RangedAudioParameter* parameter)
+{
+    if (auto* choiceParameter = dynamic_cast<juce::AudioParameterChoice*>(parameter))
+        box.addItemList(choiceParameter->choices, 1);
+}
+
 //==============================================================================
 PJKParametricEQAudioProcessorEditor::PJKParametricEQAudioProcessorEditor (PJKParametricEQAudioProcessor& p)
     : AudioProcessorEditor (&p), audioProcessor (p),
@@ -167,22 +187,6 @@ PJKParametricEQAudioProcessorEditor::PJKParametricEQAudioProcessorEditor (PJKPar
     lowPassFreqSlider(*audioProcessor.state.getParameter("LowPass Freq"), "Hz"),
     lowPassSlopeSlider(*audioProcessor.state.getParameter("LowPass Slope"), "dB/oct"),
 
-    filter1FreqSlider(*audioProcessor.state.getParameter("Filter1 Freq"), "Hz"),
-    filter2FreqSlider(*audioProcessor.state.getParameter("Filter2 Freq"), "Hz"),
-    filter3FreqSlider(*audioProcessor.state.getParameter("Filter3 Freq"), "Hz"),
-    filter4FreqSlider(*audioProcessor.state.getParameter("Filter4 Freq"), "Hz"),
-
-    filter1GainSlider(*audioProcessor.state.getParameter("Filter1 Gain"), "dB"),
-    filter2GainSlider(*audioProcessor.state.getParameter("Filter2 Gain"), "dB"),
-    filter3GainSlider(*audioProcessor.state.getParameter("Filter3 Gain"), "dB"),
-    filter4GainSlider(*audioProcessor.state.getParameter("Filter4 Gain"), "dB"),
-
-    filter1QualitySlider(*audioProcessor.state.getParameter("Filter1 Quality"), ""),
-    filter2QualitySlider(*audioProcessor.state.getParameter("Filter2 Quality"), ""),
-    filter3QualitySlider(*audioProcessor.state.getParameter("Filter3 Quality"), ""),
-    filter4QualitySlider(*audioProcessor.state.getParameter("Filter4 Quality"), ""),
-
-
     frequencyResponse(audioProcessor),
         
     highPassFreqSliderAttachment(audioProcessor.state, "HighPass Freq",highPassFreqSlider),
@@ -191,34 +195,10 @@ PJKParametricEQAudioProcessorEditor::PJKParametricEQAudioProcessorEditor (PJKPar
     lowPassFreqSliderAttachment(audioProcessor.state, "LowPass Freq", lowPassFreqSlider),
     lowPassSlopeSliderAttachment(audioProcessor.state, "LowPass Slope", lowPassSlopeSlider),
 
-    filter1FreqSliderAttachment(audioProcessor.state, "Filter1 Freq", filter1FreqSlider),
-    filter2FreqSliderAttachment(audioProcessor.state, "Filter2 Freq", filter2FreqSlider),
-    filter3FreqSliderAttachment(audioProcessor.state, "Filter3 Freq", filter3FreqSlider),
-    filter4FreqSliderAttachment(audioProcessor.state, "Filter4 Freq", filter4FreqSlider),
-
-    filter1GainSliderAttachment(audioProcessor.state, "Filter1 Gain", filter1GainSlider),
-    filter2GainSliderAttachment(audioProcessor.state, "Filter2 Gain", filter2GainSlider),
-    filter3GainSliderAttachment(audioProcessor.state, "Filter3 Gain", filter3GainSlider),
-    filter4GainSliderAttachment(audioProcessor.state, "Filter4 Gain", filter4GainSlider),
-
-    filter1QualitySliderAttachment(audioProcessor.state, "Filter1 Quality", filter1QualitySlider),
-    filter2QualitySliderAttachment(audioProcessor.state, "Filter2 Quality", filter2QualitySlider),
-    filter3QualitySliderAttachment(audioProcessor.state, "Filter3 Quality", filter3QualitySlider),
-    filter4QualitySliderAttachment(audioProcessor.state, "Filter4 Quality", filter4QualitySlider),
-
-    filter1TypeSliderAttachment(audioProcessor.state, "Filter1 Type", filter1TypeSlider),
-    filter2TypeSliderAttachment(audioProcessor.state, "Filter2 Type", filter2TypeSlider),
-    filter3TypeSliderAttachment(audioProcessor.state, "Filter3 Type", filter3TypeSlider),
-    filter4TypeSliderAttachment(audioProcessor.state, "Filter4 Type", filter4TypeSlider),
-    
     gainSliderAttachment(audioProcessor.state, "Gain", gainSlider),
 
     highPassTextButtonAttachment(audioProcessor.state, "HighPass Off", highPassTextButton),
-    lowPassTextButtonAttachment(audioProcessor.state, "LowPass Off", lowPassTextButton),
-    filter1TextButtonAttachment(audioProcessor.state, "Filter1 Off", filter1TextButton),
-    filter2TextButtonAttachment(audioProcessor.state, "Filter2 Off", filter2TextButton),
-    filter3TextButtonAttachment(audioProcessor.state, "Filter3 Off", filter3TextButton),
-    filter4TextButtonAttachment(audioProcessor.state, "Filter4 Off", filter4TextButton)
+    lowPassTextButtonAttachment(audioProcessor.state, "LowPass Off", lowPassTextButton)
 {
     // Make sure that before the constructor has finished, you've set the
     // editor's size to whatever you need it to be.
@@ -232,29 +212,34 @@ PJKParametricEQAudioProcessorEditor::PJKParametricEQAudioProcessorEditor (PJKPar
     addAndMakeVisible(lowPassSlopeSlider);
     addAndMakeVisible(lowPassTextButton);
 
-    addAndMakeVisible(filter1FreqSlider);
-    addAndMakeVisible(filter1GainSlider);
-    addAndMakeVisible(filter1QualitySlider);
-    addAndMakeVisible(filter1TextButton);
-    addAndMakeVisible(filter1TypeSlider);
-
-    addAndMakeVisible(filter2FreqSlider);
-    addAndMakeVisible(filter2GainSlider);
-    addAndMakeVisible(filter2QualitySlider);
-    addAndMakeVisible(filter2TextButton);
-    addAndMakeVisible(filter2TypeSlider);
-
-    addAndMakeVisible(filter3FreqSlider);
-    addAndMakeVisible(filter3GainSlider);
-    addAndMakeVisible(filter3QualitySlider);
-    addAndMakeVisible(filter3TextButton);
-    addAndMakeVisible(filter3TypeSlider);
-
-    addAndMakeVisible(filter4FreqSlider);
-    addAndMakeVisible(filter4GainSlider);
-    addAndMakeVisible(filter4QualitySlider);
-    addAndMakeVisible(filter4TextButton);
-    addAndMakeVisible(filter4TypeSlider);
+    //kolumny pasm na zmian w dwch kolorach
+    for (int column = 0; column < bandsPerPage; ++column)
+    {
+        auto& bandColumn = bandColumns[(size_t) column];
+        bandColumn = std::make_unique<BandColumn>(audioProcessor.state, column,
+            column % 2 == 0 ? juce::Colour(53, 114, 102) : juce::Colour(101, 83, 47));
+
+        addAndMakeVisible(bandColumn->freqSlider);
+        addAndMakeVisible(bandColumn->gainSlider);
+        addAndMakeVisible(bandColumn->qualitySlider);
+        addAndMakeVisible(bandColumn->textButton);
+        addAndMakeVisible(bandColumn->typeSlider);
+
+        addAndMakeVisible(bandColumn->dynamicButton);
+        addAndMakeVisible(bandColumn->sidechainButton);
+        addAndMakeVisible(bandColumn->channelBox);
+        addAndMakeVisible(bandColumn->thresholdSlider);
+        addAndMakeVisible(bandColumn->ratioSlider);
+        addAndMakeVisible(bandColumn->attackSlider);
+        addAndMakeVisible(bandColumn->releaseSlider);
+    }
+
+    //strony pasm: 1-4, 5-8, ...
+    for (int page = 0; page < maxBands / bandsPerPage; ++page)
+        bandPageBox.addItem("Bands " + juce::String(page * bandsPerPage + 1) + "-" + juce::String((page + 1) * bandsPerPage), page + 1);
+    bandPageBox.setSelectedItemIndex(0, juce::dontSendNotification);
+    bandPageBox.onChange = [this] { showBandPage(bandPageBox.getSelectedItemIndex()); };
+    addAndMakeVisible(bandPageBox);
 
     addAndMakeVisible(gainSlider);
     addAndMakeVisible(frequencyResponse);
@@ -262,7 +247,26 @@ PJKParametricEQAudioProcessorEditor::PJKParametricEQAudioProcessorEditor (PJKPar
     addAndMakeVisible(leftMeter);
     addAndMakeVisible(rightMeter);
 
-    setSize (700, 500);
+    loudnessButton.onClick = [this] { audioProcessor.getOutputMeter().resetTruePeak(); };
+    addAndMakeVisible(loudnessButton);
+
+    //wybr nadprbkowania, trybu fazy, precyzji i trybu kanaw - pozycje z parametrw,
+    //attachment dopiero gdy lista jest wypeniona
+    using ComboBoxAttachment = juce::AudioProcessorValueTreeState::ComboBoxAttachment;
+    auto attachChoice = [this](juce::ComboBox& box, const juce::String& id, std::unique_ptr<ComboBoxAttachment>& attachment)
+    {
+        addChoices(box, audioProcessor.state.getParameter(id));
+        attachment = std::make_unique<ComboBoxAttachment>(audioProcessor.state, id, box);
+        addAndMakeVisible(box);
+    };
+
+    attachChoice(oversamplingBox, "Oversampling", oversamplingBoxAttachment);
+    attachChoice(oversamplingFilterBox, "Oversampling Filter", oversamplingFilterBoxAttachment);
+    attachChoice(phaseModeBox, "Phase Mode", phaseModeBoxAttachment);
+    attachChoice(precisionBox, "Precision", precisionBoxAttachment);
+    attachChoice(channelModeBox, "Channel Mode", channelModeBoxAttachment);
+
+    setSize (700, 500 + dynamicsHeight);
 
     startTimerHz(30);
 }
@@ -272,6 +276,93 @@ PJKParametricEQAudioProcessorEditor::~PJKParametricEQAudioProcessorEditor()
    
 }
 
+void PJKParametricEQAudioProcessorEditor::showBandPage(int page)
+{
+    for (int column = 0; column < bandsPerPage; ++column)
+        bandColumns[(size_t) column]->setBand(page * bandsPerPage + column);
+}
+
+BandColumn::BandColumn(juce::AudioProcessorValueTreeState& s, int band, juce::Colour c)
+    : freqSlider(*s.getParameter(getParameterID(getBandParameter(band, BandFreq))), "Hz"),
+    gainSlider(*s.getParameter(getParameterID(getBandParameter(band, BandGain))), "dB"),
+    qualitySlider(*s.getParameter(getParameterID(getBandParameter(band, BandQuality))), ""),
+    colour(c),
+    thresholdSlider(*s.getParameter(getParameterID(getBandParameter(band, BandThreshold))), "dB", "T"),
+    ratioSlider(*s.getParameter(getParameterID(getBandParameter(band, BandRatio))), ":1", "R"),
+    attackSlider(*s.getParameter(getParameterID(getBandParameter(band, BandAttack))), "ms", "A"),
+    releaseSlider(*s.getParameter(getParameterID(getBandParameter(band, BandRelease))), "ms", "Rel"),
+    state(s)
+{
+    typeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 80, 20);
+
+    textButton.setClickingTogglesState(true);
+    textButton.setColour(juce::TextButton::ColourIds::textColourOnId, juce::Colours::lightgrey);
+    textButton.setColour(juce::TextButton::ColourIds::textColourOffId, juce::Colours::white);
+    textButton.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::black);
+    textButton.setColour(juce::TextButton::ColourIds::buttonColourId, colour);
+
+    //wczniki pasma dynamicznego - zawiecone, gdy wczone (odwrotnie ni wycznik pasma)
+    for (auto* button : { &dynamicButton, &sidechainButton })
+    {
+        button->setClickingTogglesState(true);
+        button->setColour(juce::TextButton::ColourIds::textColourOnId, juce::Colours::black);
+        button->setColour(juce::TextButton::ColourIds::textColourOffId, juce::Colours::lightgrey);
+        button->setColour(juce::TextButton::ColourIds::buttonOnColourId, colour.brighter(0.8f));
+        button->setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::black);
+    }
+    dynamicButton.setButtonText("Dynamic");
+    sidechainButton.setButtonText("Sidechain");
+
+    //pozycje jednakowe dla wszystkich pasm
+    addChoices(channelBox, s.getParameter(getParameterID(getBandParameter(band, BandChannel))));
+
+    setBand(band);
+}
+
+void BandColumn::setBand(int band)
+{
+    auto id = [band](BandParameter parameter) { return getParameterID(getBandParameter(band, parameter)); };
+
+    //stare attachmenty odczane przed podczeniem nowych
+    freqAttachment.reset();
+    gainAttachment.reset();
+    qualityAttachment.reset();
+    typeAttachment.reset();
+    textButtonAttachment.reset();
+    thresholdAttachment.reset();
+    ratioAttachment.reset();
+    attackAttachment.reset();
+    releaseAttachment.reset();
+    dynamicButtonAttachment.reset();
+    sidechainButtonAttachment.reset();
+    channelBoxAttachment.reset();
+
+    freqSlider.setParameter(*state.getParameter(id(BandFreq)));
+    gainSlider.setParameter(*state.getParameter(id(BandGain)));
+    qualitySlider.setParameter(*state.getParameter(id(BandQuality)));
+    thresholdSlider.setParameter(*state.getParameter(id(BandThreshold)));
+    ratioSlider.setParameter(*state.getParameter(id(BandRatio)));
+    attackSlider.setParameter(*state.getParameter(id(BandAttack)));
+    releaseSlider.setParameter(*state.getParameter(id(BandRelease)));
+
+    using Attachment = juce::AudioProcessorValueTreeState::SliderAttachment;
+    freqAttachment = std::make_unique<Attachment>(state, id(BandFreq), freqSlider);
+    gainAttachment = std::make_unique<Attachment>(state, id(BandGain), gainSlider);
+    qualityAttachment = std::make_unique<Attachment>(state, id(BandQuality), qualitySlider);
+    typeAttachment = std::make_unique<Attachment>(state, id(BandType), typeSlider);
+    textButtonAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(state, id(BandOff), textButton);
+
+    thresholdAttachment = std::make_unique<Attachment>(state, id(BandThreshold), thresholdSlider);
+    ratioAttachment = std::make_unique<Attachment>(state, id(BandRatio), ratioSlider);
+    attackAttachment = std::make_unique<Attachment>(state, id(BandAttack), attackSlider);
+    releaseAttachment = std::make_unique<Attachment>(state, id(BandRelease), releaseSlider);
+    dynamicButtonAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(state, id(BandDynamic), dynamicButton);
+    sidechainButtonAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(state, id(BandSidechain), sidechainButton);
+    channelBoxAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(state, id(BandChannel), channelBox);
+
+    textButton.setButtonText("Filter " + juce::String(band + 1));
+}
+
 //==============================================================================
 
 void PJKParametricEQAudioProcessorEditor::paint (juce::Graphics& g)
@@ -281,16 +372,12 @@ void PJKParametricEQAudioProcessorEditor::paint (juce::Graphics& g)
     auto b = getLocalBounds();
     auto gainBounds = b.removeFromRight(100);
 
-    auto frequencyResponseBounds = b.removeFromTop(b.getHeight() * 0.5);
+    //poowa wysokoci bez paska pasm dynamicznych - kolumny sigaj przez pasek do dou
+    auto frequencyResponseBounds = b.removeFromTop((b.getHeight() - dynamicsHeight) / 2);
 
     frequencyResponse.setBounds(frequencyResponseBounds);
 
     auto highPassBounds = b.removeFromLeft(100);
-    auto filter1Bounds = b.removeFromLeft(100);
-    auto filter2Bounds = b.removeFromLeft(100);
-    auto filter3Bounds = b.removeFromLeft(100);
-    auto filter4Bounds = b.removeFromLeft(100);
-    auto lowPassBounds = b.removeFromLeft(100);
     
 
     g.setColour(juce::Colour(49, 37, 9));
@@ -299,17 +386,12 @@ void PJKParametricEQAudioProcessorEditor::paint (juce::Graphics& g)
     g.setColour(juce::Colour(14, 59, 67));
     g.fillRect(highPassBounds);
     
-    g.setColour(juce::Colour(53, 114, 102));
-    g.fillRect(filter1Bounds);
-
-    g.setColour(juce::Colour(101, 83, 47));
-    g.fillRect(filter2Bounds);
-
-    g.setColour(juce::Colour(53, 114, 102));
-    g.fillRect(filter3Bounds);
-
-    g.setColour(juce::Colour(101, 83, 47));
-    g.fillRect(filter4Bounds);
+    for (auto& bandColumn : bandColumns)
+    {
+        g.setColour(bandColumn->colour);
+        g.fillRect(b.removeFromLeft(100));
+    }
+    auto lowPassBounds = b.removeFromLeft(100);
 
     g.setColour(juce::Colour(14, 59, 67));
     g.fillRect(lowPassBounds);
@@ -329,11 +411,6 @@ void PJKParametricEQAudioProcessorEditor::paint (juce::Graphics& g)
     gainSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 50, 25);
    
 
-    filter1TypeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 80, 20);
-    filter2TypeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 80, 20);
-    filter3TypeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 80, 20);
-    filter4TypeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 80, 20);
-
     //wygld buttonw 
 
     highPassTextButton.setButtonText("High-Pass");
@@ -343,35 +420,6 @@ void PJKParametricEQAudioProcessorEditor::paint (juce::Graphics& g)
     highPassTextButton.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::black);
     highPassTextButton.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colour(14, 59, 67));
 
-    filter1TextButton.setButtonText("Filter 1");
-    filter1TextButton.setClickingTogglesState(true);
-    filter1TextButton.setColour(juce::TextButton::ColourIds::textColourOnId, juce::Colours::lightgrey);
-    filter1TextButton.setColour(juce::TextButton::ColourIds::textColourOffId, juce::Colours::white);
-    filter1TextButton.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::black);
-    filter1TextButton.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colour(53, 114, 102));
-    
-    filter2TextButton.setButtonText("Filter 2");
-    filter2TextButton.setClickingTogglesState(true);
-    filter2TextButton.setColour(juce::TextButton::ColourIds::textColourOnId, juce::Colours::lightgrey);
-    filter2TextButton.setColour(juce::TextButton::ColourIds::textColourOffId, juce::Colours::white);
-    filter2TextButton.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::black);
-    filter2TextButton.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colour(101, 83, 47));
-    
-    filter3TextButton.setButtonText("Filter 3");
-    filter3TextButton.setClickingTogglesState(true);
-    filter3TextButton.setColour(juce::TextButton::ColourIds::textColourOnId, juce::Colours::lightgrey);
-    filter3TextButton.setColour(juce::TextButton::ColourIds::textColourOffId, juce::Colours::white);
-    filter3TextButton.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::black);
-    filter3TextButton.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colour(53, 114, 102));
-    
-
-    filter4TextButton.setButtonText("Filter 4");
-    filter4TextButton.setClickingTogglesState(true);
-    filter4TextButton.setColour(juce::TextButton::ColourIds::textColourOnId, juce::Colours::lightgrey);
-    filter4TextButton.setColour(juce::TextButton::ColourIds::textColourOffId, juce::Colours::white);
-    filter4TextButton.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::black);
-    filter4TextButton.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colour(101, 83, 47));
-
     lowPassTextButton.setButtonText("Low-Pass");
     lowPassTextButton.setClickingTogglesState(true);
     lowPassTextButton.setColour(juce::TextButton::ColourIds::textColourOnId, juce::Colours::lightgrey);
@@ -387,16 +435,22 @@ void PJKParametricEQAudioProcessorEditor::resized()
 {
     auto b = getLocalBounds();
     auto gainBounds = b.removeFromRight(100);
-    auto frequencyResponseBounds = b.removeFromTop(b.getHeight() * 0.5);
+    auto frequencyResponseBounds = b.removeFromTop((b.getHeight() - dynamicsHeight) / 2);
 
     frequencyResponse.setBounds(frequencyResponseBounds);
 
+    oversamplingBox.setBounds(gainBounds.removeFromTop(20));
+    oversamplingFilterBox.setBounds(gainBounds.removeFromTop(20));
+    phaseModeBox.setBounds(gainBounds.removeFromTop(20));
+    precisionBox.setBounds(gainBounds.removeFromTop(20));
+    channelModeBox.setBounds(gainBounds.removeFromTop(20));
+    bandPageBox.setBounds(gainBounds.removeFromTop(20));
+
+    //pasek pasm dynamicznych pod kolumnami HP, pasm i LP
+    auto dynamicsBounds = b.removeFromBottom(dynamicsHeight);
+    dynamicsBounds.removeFromLeft(100);
+
     auto highPassBounds = b.removeFromLeft(100);
-    auto filter1Bounds = b.removeFromLeft(100);
-    auto filter2Bounds = b.removeFromLeft(100);
-    auto filter3Bounds = b.removeFromLeft(100);
-    auto filter4Bounds = b.removeFromLeft(100);
-    auto lowPassBounds = b.removeFromLeft(100);
 
     //zmiana granic buttonw 
 
@@ -404,34 +458,33 @@ void PJKParametricEQAudioProcessorEditor::resized()
     highPassFreqSlider.setBounds(highPassBounds.removeFromTop(highPassBounds.getHeight()*0.5));
     highPassSlopeSlider.setBounds(highPassBounds);
 
-    filter1TextButton.setBounds(filter1Bounds.removeFromTop(20));
-    filter1FreqSlider.setBounds(filter1Bounds.removeFromTop(66));
-    filter1GainSlider.setBounds(filter1Bounds.removeFromTop(66));
-    filter1QualitySlider.setBounds(filter1Bounds.removeFromTop(66));
-    filter1TypeSlider.setBounds(filter1Bounds);
-
-    filter2TextButton.setBounds(filter2Bounds.removeFromTop(20));
-    filter2FreqSlider.setBounds(filter2Bounds.removeFromTop(66));
-    filter2GainSlider.setBounds(filter2Bounds.removeFromTop(66));
-    filter2QualitySlider.setBounds(filter2Bounds.removeFromTop(66));
-    filter2TypeSlider.setBounds(filter2Bounds);
-
-    filter3TextButton.setBounds(filter3Bounds.removeFromTop(20));
-    filter3FreqSlider.setBounds(filter3Bounds.removeFromTop(66));
-    filter3GainSlider.setBounds(filter3Bounds.removeFromTop(66));
-    filter3QualitySlider.setBounds(filter3Bounds.removeFromTop(66));
-    filter3TypeSlider.setBounds(filter3Bounds);
-
-    filter4TextButton.setBounds(filter4Bounds.removeFromTop(20));
-    filter4FreqSlider.setBounds(filter4Bounds.removeFromTop(66));
-    filter4GainSlider.setBounds(filter4Bounds.removeFromTop(66));
-    filter4QualitySlider.setBounds(filter4Bounds.removeFromTop(66));
-    filter4TypeSlider.setBounds(filter4Bounds);
+    for (auto& bandColumn : bandColumns)
+    {
+        auto bandBounds = b.removeFromLeft(100);
+        bandColumn->textButton.setBounds(bandBounds.removeFromTop(20));
+        bandColumn->freqSlider.setBounds(bandBounds.removeFromTop(66));
+        bandColumn->gainSlider.setBounds(bandBounds.removeFromTop(66));
+        bandColumn->qualitySlider.setBounds(bandBounds.removeFromTop(66));
+        bandColumn->typeSlider.setBounds(bandBounds);
+
+        //wczniki i kana, pod nimi pokrta jedno pod drugim (napis wartoci potrzebuje caej szerokoci)
+        auto dynamicBounds = dynamicsBounds.removeFromLeft(100);
+        bandColumn->dynamicButton.setBounds(dynamicBounds.removeFromTop(20));
+        bandColumn->sidechainButton.setBounds(dynamicBounds.removeFromTop(20));
+        bandColumn->channelBox.setBounds(dynamicBounds.removeFromTop(20));
+        bandColumn->thresholdSlider.setBounds(dynamicBounds.removeFromTop(60));
+        bandColumn->ratioSlider.setBounds(dynamicBounds.removeFromTop(60));
+        bandColumn->attackSlider.setBounds(dynamicBounds.removeFromTop(60));
+        bandColumn->releaseSlider.setBounds(dynamicBounds.removeFromTop(60));
+    }
+    auto lowPassBounds = b.removeFromLeft(100);
 
     lowPassTextButton.setBounds(lowPassBounds.removeFromTop(20));
     lowPassFreqSlider.setBounds(lowPassBounds.removeFromTop(lowPassBounds.getHeight() * 0.5));
     lowPassSlopeSlider.setBounds(lowPassBounds);
 
+    loudnessButton.setBounds(gainBounds.removeFromBottom(20));
+
     gainSlider.setBounds(gainBounds.removeFromLeft(gainBounds.getWidth() * 0.5));    
     
     leftMeter.setBounds(gainBounds.removeFromLeft(gainBounds.getWidth() * 0.5));
@@ -442,89 +495,96 @@ void PJKParametricEQAudioProcessorEditor::resized()
 //timer callback do miernika
 void PJKParametricEQAudioProcessorEditor::timerCallback()
 {
-    leftMeter.setLevel(audioProcessor.getRMSValue(0));
-    rightMeter.setLevel(audioProcessor.getRMSValue(1));
+    //przy mono oba mierniki pokazuj ten sam kana
+    const auto& meter = audioProcessor.getOutputMeter();
+    const auto rightChannel = audioProcessor.getMainBusNumInputChannels() > 1 ? 1 : 0;
+
+    leftMeter.setLevel(meter.getRMS(0));
+    leftMeter.setPeak(meter.getPeak(0));
+    rightMeter.setLevel(meter.getRMS(rightChannel));
+    rightMeter.setPeak(meter.getPeak(rightChannel));
 
     leftMeter.repaint();
     rightMeter.repaint();
+
+    //M i S w LUFS, TP - wikszy z kanaw wywietlanych
+    const auto truePeak = juce::jmax(meter.getTruePeak(0), meter.getTruePeak(rightChannel));
+    loudnessButton.setButtonText("M " + juce::String(meter.getMomentaryLoudness(), 1)
+                               + " S " + juce::String(meter.getShortTermLoudness(), 1)
+                               + " TP " + juce::String(truePeak, 1));
 }
 
 
 //charakterystyka
 FrequencyResponse::FrequencyResponse(PJKParametricEQAudioProcessor& p) :audioProcessor(p)
 {
-    const auto& parameters = audioProcessor.getParameters();
-    for (auto parameter : parameters)
-    {
-        parameter->addListener(this);
-    }
-    updateFrequencyResponse();
+    audioProcessor.getSpectrumTap().setEnabled(true);
+    worker->addClient(this);
     startTimerHz(60);
 }
 
 
 FrequencyResponse::~FrequencyResponse()
 {
-    const auto& parameters = audioProcessor.getParameters();
-    for (auto parameter : parameters)
-    {
-        parameter->removeListener(this);
-    }
+    worker->removeClient(this);
+    audioProcessor.getSpectrumTap().setEnabled(false);
 }
 
-void FrequencyResponse::parameterValueChanged(int parameterIndex, float newValue)
+//odbir gotowych cieek
+void FrequencyResponse::timerCallback()
 {
-    parametersValueChanged.set(true);
+    if (curves.acquire())
+        repaint();
 }
-//aktualizacja parametrw przez krzyw
-void FrequencyResponse::timerCallback()
+
+//wtek roboczy: nowa migawka wspczynnikw albo nowy rozmiar - przeliczane tylko zmienione sekcje;
+//widmo - ramki z prbek, ktre przyszy od ostatniego wywoania
+void FrequencyResponse::updateResponse()
 {
-    if (parametersValueChanged.compareAndSetBool(false, true))
+    bool changed = false;
+    if (bounds.acquire())
     {
-        updateFrequencyResponse();
-        repaint();
+        workerBounds = bounds.getReadBuffer();
+        changed = true;
     }
 
-    
-}
+    const auto newCoefficients = audioProcessor.pullDisplayCoefficients();
+    const auto& coefficients = audioProcessor.getDisplayCoefficients();
+    if (coefficients.sampleRate <= 0 || workerBounds.isEmpty())
+        return;
 
-void FrequencyResponse::updateFrequencyResponse()
-{
-    auto settings = getSettings(audioProcessor.state);
-
-    //buttony w editorze
-    chain.setBypassed<Positions::HighPass>(settings.highPassOff);
-    chain.setBypassed<Positions::LowPass>(settings.lowPassOff);
-    chain.setBypassed<Positions::Filter1>(settings.filter1Off);
-    chain.setBypassed<Positions::Filter2>(settings.filter2Off);
-    chain.setBypassed<Positions::Filter3>(settings.filter3Off);
-    chain.setBypassed<Positions::Filter4>(settings.filter4Off);
-
-    auto highPassCoeff = juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(settings.highPassFreq, audioProcessor.getSampleRate(), 2 * (settings.highPassSlope + 1));
-
-    auto lowPassCoeff = juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(settings.lowPassFreq, audioProcessor.getSampleRate(), 2 * (settings.lowPassSlope + 1));
-
-    updatePassFilter(chain.get<Positions::HighPass>(), highPassCoeff, settings.highPassSlope);
-    updatePassFilter(chain.get<Positions::LowPass>(), lowPassCoeff, settings.lowPassSlope);
-
-    auto filter1Coeff = createFilters1_4(settings, audioProcessor.getSampleRate(), 0);
-    auto filter2Coeff = createFilters1_4(settings, audioProcessor.getSampleRate(), 1);
-    auto filter3Coeff = createFilters1_4(settings, audioProcessor.getSampleRate(), 2);
-    auto filter4Coeff = createFilters1_4(settings, audioProcessor.getSampleRate(), 3);
-    updateCoefficients(chain.get<Positions::Filter1>().coefficients, filter1Coeff);
-    updateCoefficients(chain.get<Positions::Filter1>().coefficients, filter1Coeff);
-    updateCoefficients(chain.get<Positions::Filter2>().coefficients, filter2Coeff);
-    updateCoefficients(chain.get<Positions::Filter2>().coefficients, filter2Coeff);
-    updateCoefficients(chain.get<Positions::Filter3>().coefficients, filter3Coeff);
-    updateCoefficients(chain.get<Positions::Filter3>().coefficients, filter3Coeff);
-    updateCoefficients(chain.get<Positions::Filter4>().coefficients, filter4Coeff);
-    updateCoefficients(chain.get<Positions::Filter4>().coefficients, filter4Coeff);
+    changed |= renderer.setGrid(workerBounds.getWidth(), coefficients.sampleRate);
 
+    if (newCoefficients || changed)
+        for (int i = 0; i < ChainCoefficients::numSections; ++i)
+            changed |= renderer.setSection(i, coefficients.getSection(i), coefficients.isActive(i));
+
+    auto& tap = audioProcessor.getSpectrumTap();
+    for (int point = 0; point < SpectrumTap::NumPoints; ++point)
+    {
+        changed |= spectra[(size_t) point].setGrid(workerBounds.getWidth(), tap.getSampleRate());
+        changed |= spectra[(size_t) point].update(tap, (SpectrumTap::Point) point);
+    }
+
+    if (!changed)
+        return;
+
+    //bufor do zapisu mg mie starsz zawarto - wszystkie cieki ustawiane od nowa
+    const auto area = workerBounds.toFloat();
+    auto& next = curves.getWriteBuffer();
+    next.response = renderer.getPath(area, -20.f, 20.f);
+    for (int point = 0; point < SpectrumTap::NumPoints; ++point)
+        spectra[(size_t) point].getPath(next.spectra[(size_t) point], area, spectrumMinDecibels, spectrumMaxDecibels);
+    curves.publish();
 }
 //siatka
 void FrequencyResponse::resized()
 {
     using namespace juce;
+
+    bounds.getWriteBuffer() = getResponseBounds();
+    bounds.publish();
+
     background = Image(Image::PixelFormat::RGB, getWidth(), getHeight(), true);
     Graphics g(background);
 
@@ -635,81 +695,16 @@ void FrequencyResponse::paint(juce::Graphics& g)
     g.fillAll(juce::Colours::black);
     g.drawImage(background, getLocalBounds().toFloat());
 
-    auto b = getLocalBounds();
-    auto gainBounds = b.removeFromRight(100);
-
-    auto frequencyResponseBounds = getResponseBounds();
-
-    auto width = frequencyResponseBounds.getWidth();
-
-    auto& highpass = chain.get<Positions::HighPass>();
-    auto& filter1 = chain.get<Positions::Filter1>();
-    auto& filter2 = chain.get<Positions::Filter2>();
-    auto& filter3 = chain.get<Positions::Filter3>();
-    auto& filter4 = chain.get<Positions::Filter4>();
-    auto& lowpass = chain.get<Positions::LowPass>();
-
-    auto sampleRate = audioProcessor.getSampleRate();
-
-    std::vector<double> amplitudeValues;
-    amplitudeValues.resize(width);
-
-    for (int i = 0; i < width; ++i)
-    {
-        double amplitude = 1.f;
-        auto frequency = juce::mapToLog10(double(i) / double(width), 20.0, 20000.0);
-
-            if (!chain.isBypassed<Positions::Filter1>())
-                amplitude *= filter1.coefficients->getMagnitudeForFrequency(frequency, sampleRate);
-            if (!chain.isBypassed<Positions::Filter2>())
-                amplitude *= filter2.coefficients->getMagnitudeForFrequency(frequency, sampleRate);
-            if (!chain.isBypassed<Positions::Filter3>())
-                amplitude *= filter3.coefficients->getMagnitudeForFrequency(frequency, sampleRate);
-            if (!chain.isBypassed<Positions::Filter4>())
-                amplitude *= filter4.coefficients->getMagnitudeForFrequency(frequency, sampleRate);
-        
-        if (!chain.isBypassed<Positions::HighPass>())
-        {
-            if (!highpass.isBypassed<0>())
-                amplitude *= highpass.get<0>().coefficients->getMagnitudeForFrequency(frequency, sampleRate);
-            if (!highpass.isBypassed<1>())
-                amplitude *= highpass.get<1>().coefficients->getMagnitudeForFrequency(frequency, sampleRate);
-            if (!highpass.isBypassed<2>())
-                amplitude *= highpass.get<2>().coefficients->getMagnitudeForFrequency(frequency, sampleRate);
-            if (!highpass.isBypassed<3>())
-                amplitude *= highpass.get<3>().coefficients->getMagnitudeForFrequency(frequency, sampleRate);
-        }
-        if (!chain.isBypassed<Positions::LowPass>())
-        {
-            if (!lowpass.isBypassed<0>())
-                amplitude *= lowpass.get<0>().coefficients->getMagnitudeForFrequency(frequency, sampleRate);
-            if (!lowpass.isBypassed<1>())
-                amplitude *= lowpass.get<1>().coefficients->getMagnitudeForFrequency(frequency, sampleRate);
-            if (!lowpass.isBypassed<2>())
-                amplitude *= lowpass.get<2>().coefficients->getMagnitudeForFrequency(frequency, sampleRate);
-            if (!lowpass.isBypassed<3>())
-                amplitude *= lowpass.get<3>().coefficients->getMagnitudeForFrequency(frequency, sampleRate);
-        }
-        amplitudeValues[i] = juce::Decibels::gainToDecibels(amplitude);
-
-    }
-
-    juce::Path frequencyResponse;
-    const double bottom = frequencyResponseBounds.getBottom();
-    const double top = frequencyResponseBounds.getY();
-
-    frequencyResponse.startNewSubPath(frequencyResponseBounds.getX(), juce::jmap(amplitudeValues.front(), -20.0, 20.0, bottom, top));
-
-    for (int i = 0; i < amplitudeValues.size(); ++i)
-    {
-        frequencyResponse.lineTo(frequencyResponseBounds.getX() + i, juce::jmap(amplitudeValues[i], -20.0, 20.0, bottom, top));
-       
-    }
+    //ostatnie cieki opublikowane przez wtek roboczy: widmo przed i po korekcji, charakterystyka
+    const auto& published = curves.getReadBuffer();
 
+    g.setColour(juce::Colours::grey.withAlpha(0.4f));
+    g.fillPath(published.spectra[SpectrumTap::Pre]);
+    g.setColour(juce::Colour(208, 229, 98).withAlpha(0.35f));
+    g.fillPath(published.spectra[SpectrumTap::Post]);
 
     g.setColour(juce::Colours::white);
-    g.strokePath(frequencyResponse, juce::PathStrokeType(2.f));
-
+    g.strokePath(published.response, juce::PathStrokeType(2.f));
 }
 
 juce::Rectangle<int> FrequencyResponse::getResponseBounds()
@@ -753,6 +748,13 @@ void LevelMeter::paint(juce::Graphics& g)
     }
     g.fillRoundedRectangle(b.removeFromBottom(height), 4.f);
 
+    //szczyt prbkowy jako linia
+    if (peak > -60.f)
+    {
+        g.setColour(peak >= 0 ? Colours::red : Colours::white);
+        g.drawHorizontalLine((int) jmap(jmin(peak, 0.f), -60.f, 0.f, t.getBottom(), t.getY()), t.getX(), t.getRight());
+    }
+
     Array<float> gains
     {
         -48, -36, -24, -18, -12, -9, -6, -3,
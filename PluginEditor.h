@@ -10,14 +10,16 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "ResponseRenderer.h"
 //miernik RMS
 struct LevelMeter : juce::Component
 {
 public:
     void paint(juce::Graphics& g) override;
     void setLevel(const float value) { level = value; }
+    void setPeak(const float value) { peak = value; }
 private:
-    float level = -60.f;
+    float level = -60.f, peak = -60.f;
 };
 
 struct LookAndFeel :juce::LookAndFeel_V4
@@ -33,9 +35,10 @@ struct LookAndFeel :juce::LookAndFeel_V4
 //wygld pokrte
 struct KnobWithText :juce::Slider
 {
-    KnobWithText(juce::RangedAudioParameter& parameter, const juce::String& unitString):
+    //labelString - napis przed wartoci; pusty: napis wynika z jednostki (f, G, Q, Sl)
+    KnobWithText(juce::RangedAudioParameter& parameter, const juce::String& unitString, const juce::String& labelString = {}):
         juce::Slider(juce::Slider::SliderStyle::RotaryHorizontalVerticalDrag,
-        juce::Slider::TextEntryBoxPosition::NoTextBox), rap(&parameter), unit(unitString)
+        juce::Slider::TextEntryBoxPosition::NoTextBox), rap(&parameter), unit(unitString), label(labelString)
     {
         setLookAndFeel(&lookAndFeel);
     }
@@ -45,36 +48,87 @@ struct KnobWithText :juce::Slider
         setLookAndFeel(nullptr);
     }
     void paint(juce::Graphics& g) override;
+    //kolumna pasma przeczona na inne pasmo
+    void setParameter(juce::RangedAudioParameter& parameter) { rap = &parameter; repaint(); }
     juce::Rectangle<int> getKnobBounds() const;
     juce::String getString() const;
     juce::String getUnit() { return unit; }
+    juce::String getLabel() { return label; }
 private:
     LookAndFeel lookAndFeel; 
     juce::RangedAudioParameter* rap;
-    juce::String unit;
+    juce::String unit, label;
 };
 
-//Charakterystyka
+//kolumna pasma: czstotliwo, wzmocnienie, dobro, typ i wycznik, pod nimi pasmo dynamiczne
+//(wcznik, prg, stosunek, atak, zwolnienie, detektor na sidechainie) i kana pasma; edytor ma kilka
+//kolumn i przecza je midzy stronami pasm, attachmenty tworzone od nowa dla wybranego pasma
+struct BandColumn
+{
+    BandColumn(juce::AudioProcessorValueTreeState& state, int band, juce::Colour colour);
+    void setBand(int band);
+
+    KnobWithText freqSlider, gainSlider, qualitySlider;
+    juce::Slider typeSlider{ juce::Slider::LinearHorizontal, juce::Slider::TextBoxBelow };
+    juce::TextButton textButton;
+    juce::Colour colour;
+
+    //pasmo dynamiczne i kana
+    KnobWithText thresholdSlider, ratioSlider, attackSlider, releaseSlider;
+    juce::TextButton dynamicButton, sidechainButton;
+    juce::ComboBox channelBox;
+
+private:
+    juce::AudioProcessorValueTreeState& state;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> freqAttachment, gainAttachment,
+        qualityAttachment, typeAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> textButtonAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> thresholdAttachment, ratioAttachment,
+        attackAttachment, releaseAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> dynamicButtonAttachment,
+        sidechainButtonAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> channelBoxAttachment;
+};
+
+//Charakterystyka - krzywa liczona we wsplnym wtku ResponseWorker ze wspczynnikw
+//zaprojektowanych ju przez procesor, tutaj tylko odbierana i rysowana. W tym samym wtku
+//liczone jest widmo sygnau przed i po korekcji
 struct FrequencyResponse : juce::Component,
-    juce::AudioProcessorParameter::Listener, 
-    juce::Timer
+    juce::Timer,
+    ResponseWorker::Client
 {
     FrequencyResponse(PJKParametricEQAudioProcessor&);
     ~FrequencyResponse();
-    void parameterValueChanged(int parameterIndex, float newValue) override;
-    void parameterGestureChanged(int parameterIndex, bool gestureIsStarting) {};
     void timerCallback() override;
     void paint(juce::Graphics& g) override;
     void resized() override;
+    void updateResponse() override;
 
 private:
     // This reference is provided as a quick way for your editor to
     // access the processor object that created it.
     PJKParametricEQAudioProcessor& audioProcessor;
-    //czy parametry si zmieniy
-    juce::Atomic<bool> parametersValueChanged{ false };
-    Chain chain;
-    void updateFrequencyResponse();
+
+    //zakres osi widma w dBFS
+    static constexpr float spectrumMinDecibels = -90.f, spectrumMaxDecibels = 0.f;
+
+    //stan wtku roboczego
+    ResponseRenderer renderer;
+    std::array<SpectrumAnalyzer, SpectrumTap::NumPoints> spectra;
+    juce::Rectangle<int> workerBounds;
+
+    //gotowe cieki: charakterystyka i widma z odczepw
+    struct Curves
+    {
+        juce::Path response;
+        std::array<juce::Path, SpectrumTap::NumPoints> spectra;
+    };
+
+    //wtek wiadomoci -> wtek roboczy: prostokt krzywej; wtek roboczy -> wtek wiadomoci: gotowe cieki
+    TripleBuffer<juce::Rectangle<int>> bounds;
+    TripleBuffer<Curves> curves;
+
+    juce::SharedResourcePointer<ResponseWorker> worker;
 
     //siatka
     juce::Image background;
@@ -109,25 +163,15 @@ private:
     KnobWithText highPassFreqSlider,
         highPassSlopeSlider,
         lowPassFreqSlider,
-        lowPassSlopeSlider,
-        filter1FreqSlider,
-        filter2FreqSlider,
-        filter3FreqSlider,
-        filter4FreqSlider,
-        filter1GainSlider,
-        filter2GainSlider,
-        filter3GainSlider,
-        filter4GainSlider,
-        filter1QualitySlider,
-        filter2QualitySlider,
-        filter3QualitySlider,
-        filter4QualitySlider;
-
-    //suwaki
-    juce::Slider filter1TypeSlider{ juce::Slider::LinearHorizontal, juce::Slider::TextBoxBelow },
-        filter2TypeSlider{ juce::Slider::LinearHorizontal, juce::Slider::TextBoxBelow },
-        filter3TypeSlider{ juce::Slider::LinearHorizontal, juce::Slider::TextBoxBelow },
-        filter4TypeSlider{ juce::Slider::LinearHorizontal, juce::Slider::TextBoxBelow };
+        lowPassSlopeSlider;
+
+    //kolumny pasm - pokazuj stron wybran w bandPageBox
+    static constexpr int bandsPerPage = 4;
+    //pasek pasm dynamicznych pod kolumnami
+    static constexpr int dynamicsHeight = 300;
+    std::array<std::unique_ptr<BandColumn>, bandsPerPage> bandColumns;
+    juce::ComboBox bandPageBox;
+    void showBandPage(int page);
 
     juce::Slider gainSlider{ juce::Slider::LinearVertical, juce::Slider::TextBoxBelow };
 
@@ -136,39 +180,15 @@ private:
         highPassSlopeSliderAttachment,
         lowPassFreqSliderAttachment,
         lowPassSlopeSliderAttachment,
-        filter1FreqSliderAttachment,
-        filter2FreqSliderAttachment,
-        filter3FreqSliderAttachment,
-        filter4FreqSliderAttachment,
-        filter1GainSliderAttachment,
-        filter2GainSliderAttachment,
-        filter3GainSliderAttachment,
-        filter4GainSliderAttachment,
-        filter1QualitySliderAttachment,
-        filter2QualitySliderAttachment,
-        filter3QualitySliderAttachment,
-        filter4QualitySliderAttachment,
-        filter1TypeSliderAttachment,
-        filter2TypeSliderAttachment,
-        filter3TypeSliderAttachment,
-        filter4TypeSliderAttachment,
         gainSliderAttachment;
 
     //wyczniki
     juce::TextButton highPassTextButton,
-        lowPassTextButton,
-        filter1TextButton,
-        filter2TextButton,
-        filter3TextButton,
-        filter4TextButton;
+        lowPassTextButton;
 
 
     juce::AudioProcessorValueTreeState::ButtonAttachment highPassTextButtonAttachment,
-        lowPassTextButtonAttachment,
-        filter1TextButtonAttachment,
-        filter2TextButtonAttachment,
-        filter3TextButtonAttachment,
-        filter4TextButtonAttachment;
+        lowPassTextButtonAttachment;
 
     //Chain chain;
     FrequencyResponse frequencyResponse;
@@ -176,6 +196,18 @@ private:
 
     //miernik RMS lewy i prawy
     LevelMeter leftMeter, rightMeter;
+    //gono momentary / short-term i szczyt rzeczywisty, kliknicie zeruje szczyt
+    juce::TextButton loudnessButton;
+
+    //nadprbkowanie
+    juce::ComboBox oversamplingBox, oversamplingFilterBox;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> oversamplingBoxAttachment,
+        oversamplingFilterBoxAttachment;
+
+    //tryb fazy, precyzja filtrw i tryb kanaw
+    juce::ComboBox phaseModeBox, precisionBox, channelModeBox;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> phaseModeBoxAttachment,
+        precisionBoxAttachment, channelModeBoxAttachment;
     
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PJKParametricEQAudioProcessorEditor)
@@ -8,6 +8,8 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "LinearPhase.h"
+#include "StateFormat.h"
 
 //==============================================================================
 PJKParametricEQAudioProcessor::PJKParametricEQAudioProcessor()
@@ -16,16 +18,34 @@ PJKParametricEQAudioProcessor::PJKParametricEQAudioProcessor()
                      #if ! JucePlugin_IsMidiEffect
                       #if ! JucePlugin_IsSynth
                        .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
+                       .withInput  ("Sidechain", juce::AudioChannelSet::stereo(), false)
                       #endif
                        .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
                      #endif
                        )
 #endif
 {
+    //nasuch zmian parametrw - projektowane s tylko zmienione sekcje
+    for (auto* parameter : getParameters())
+        parameter->addListener(this);
+
+    //mapowanie pliku nie czyta presetw - brak banku oznacza jeden pusty program
+    openPresetBank(getDefaultPresetBankFile());
+
+    //nowy ogon zgaszany hostowi w wtku wiadomoci
+    designer.onTailChanged = [this]
+    {
+        tailChanged = true;
+        triggerAsyncUpdate();
+    };
 }
 
 PJKParametricEQAudioProcessor::~PJKParametricEQAudioProcessor()
 {
+    designer.stop();
+    cancelPendingUpdate();
+    for (auto* parameter : getParameters())
+        parameter->removeListener(this);
 }
 
 //==============================================================================
@@ -61,71 +81,212 @@ bool PJKParametricEQAudioProcessor::isMidiEffect() const
    #endif
 }
 
+//ogon filtrw i opnienie nadprbkowania / liniowej fazy (FIR ma dugo ok. dwch opnie)
 double PJKParametricEQAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    const auto sampleRate = getSampleRate();
+    return filterTailSeconds.load(std::memory_order_relaxed) + (sampleRate > 0 ? 2.0 * getLatencySamples() / sampleRate : 0.0);
+}
+
+int PJKParametricEQAudioProcessor::getTailSamples() const
+{
+    return (int) std::ceil(filterTailSeconds.load(std::memory_order_relaxed) * getSampleRate()) + 2 * getLatencySamples();
+}
+
+template<typename SampleType>
+static size_t getBufferBytes(const juce::AudioBuffer<SampleType>& buffer)
+{
+    return (size_t) buffer.getNumChannels() * (size_t) buffer.getNumSamples() * sizeof(SampleType);
+}
+
+//pami instancji: obiekt procesora (z projektantem i jego buforami potrjnymi), bufory kaskad
+//biecych i przenikanych, bufory robocze, linia opniajca suchego sygnau, pasma dynamiczne,
+//odczep analizatora i liniowa faza; bez wsplnej pamici wspczynnikw i wntrza Oversampling
+CoefficientDesigner::Statistics PJKParametricEQAudioProcessor::getDesignStatistics() const
+{
+    auto statistics = designer.getStatistics();
+    statistics.instanceBytes = sizeof(*this)
+        + cascade.getMemoryBytes() + precisionCascade.getMemoryBytes()
+        + fadeCascade.getMemoryBytes() + fadePrecisionCascade.getMemoryBytes()
+        + getBufferBytes(floatScratch) + getBufferBytes(doubleScratch)
+        + getBufferBytes(presetFadeFloat) + getBufferBytes(presetFadeDouble)
+        + getBufferBytes(dryDelay) + getBufferBytes(dryBlock)
+        + dynamicBands.getMemoryBytes() + spectrumTap.getMemoryBytes()
+        + (linearPhase != nullptr ? sizeof(LinearPhaseConvolver) + linearPhase->getMemoryBytes() : 0);
+    return statistics;
 }
 
+//programy to presety z banku
 int PJKParametricEQAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
+    return juce::jmax(1, presetBank.getNumPresets());   // NB: some hosts don't cope very well if you tell them there are 0 programs,
                 // so this should be at least 1, even if you're not really implementing programs.
 }
 
 int PJKParametricEQAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return currentProgram;
 }
 
+//wartoci czytane wprost z mapowanego pliku; tor przenika do nowego presetu zamiast interpolowa sekcje
 void PJKParametricEQAudioProcessor::setCurrentProgram (int index)
 {
+    std::array<float, NumParameters> values;
+    const auto numValues = presetBank.getValues(index, values.data(), NumParameters);
+    if (numValues == 0)
+        return;
+
+    currentProgram = index;
+    setParameterValues(values.data(), numValues, true);
 }
 
 const juce::String PJKParametricEQAudioProcessor::getProgramName (int index)
 {
-    return {};
+    return presetBank.getName(index);
 }
 
+//bank jest tylko do odczytu
 void PJKParametricEQAudioProcessor::changeProgramName (int index, const juce::String& newName)
 {
 }
 
+bool PJKParametricEQAudioProcessor::openPresetBank(const juce::File& file)
+{
+    currentProgram = 0;
+    return presetBank.open(file);
+}
+
+juce::File PJKParametricEQAudioProcessor::getDefaultPresetBankFile()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile(JucePlugin_Name).getChildFile("Presets.pjkbank");
+}
+
 //==============================================================================
 //Przygotowanie programu
 void PJKParametricEQAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
     // Use this method as the place to do any pre-playback
     // initialisation that you need..
-    
-    getLatencySamples();
-    
-    juce::dsp::ProcessSpec ps;
-    ps.numChannels = 1; //jeden kana mono
-    ps.sampleRate = sampleRate;
-    ps.maximumBlockSize = samplesPerBlock;
-    
-    leftChain.prepare(ps);
-    rightChain.prepare(ps);
 
-    //wzmocnienie
-    gain.prepare(ps);
-    gain.setRampDurationSeconds(0.01);
+    prepareProcessing(sampleRate, samplesPerBlock);
 
-    //aktualizacja filtrw
-    updateAllFilters();
+    spectrumTap.setSampleRate(sampleRate);
 
-    //reset miernika
-    leftRMSLevel.reset(sampleRate, 0.4f);
-    rightRMSLevel.reset(sampleRate, 0.4f);
+    //wzmocnienie i reset miernikw
+    outputMeter.prepare(sampleRate, getMainBusNumInputChannels(), samplesPerBlock);
 
-    leftRMSLevel.setCurrentAndTargetValue(-100.f);
-    rightRMSLevel.setCurrentAndTargetValue(-100.f);
+    //detektory pasm dynamicznych pracuj z czstotliwoci hosta
+    dynamicBands.prepare(sampleRate, samplesPerBlock, coefficientSubBlockSize);
 }
 
 void PJKParametricEQAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+    oversampling.reset();
+    linearPhase.reset();
+    preparedSampleRate = 0;
+}
+
+//tor filtrw (z ewentualnym nadprbkowaniem) dla biecych ustawie
+void PJKParametricEQAudioProcessor::prepareProcessing(double sampleRate, int samplesPerBlock)
+{
+    preparedSampleRate = sampleRate;
+    preparedBlockSize = samplesPerBlock;
+
+    const auto factor = (int) parameters.get(ParameterIndex::Oversampling);
+    oversamplingFilter = (int) parameters.get(ParameterIndex::OversamplingFilter);
+    const auto numChannels = getMainBusNumInputChannels();
+
+    //bufory nadprbkowania tylko gdy tryb jest wczony
+    oversampling.reset();
+    if (factor > 0)
+    {
+        oversampling = std::make_unique<juce::dsp::Oversampling<float>>((size_t) numChannels, (size_t) factor,
+            oversamplingFilter == 0 ? juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR
+                                    : juce::dsp::Oversampling<float>::filterHalfBandFIREquiripple,
+            true, true);
+        oversampling->initProcessing((size_t) samplesPerBlock);
+    }
+    oversamplingFactor = factor;
+
+    juce::dsp::ProcessSpec ps;
+    ps.numChannels = numChannels; //wszystkie kanay w jednym torze
+    ps.sampleRate = sampleRate * (1 << factor);
+    ps.maximumBlockSize = samplesPerBlock * (1 << factor);
+
+    cascade.setSmoothing(coefficientSubBlockSize, coefficientRampSeconds);
+    cascade.prepare(ps);
+    precisionCascade.setSmoothing(coefficientSubBlockSize, coefficientRampSeconds);
+    precisionCascade.prepare(ps);
+
+    //poprzedni tor przy zmianie presetu i kopia bloku dla niego
+    fadeCascade.setSmoothing(coefficientSubBlockSize, coefficientRampSeconds);
+    fadeCascade.prepare(ps);
+    fadePrecisionCascade.setSmoothing(coefficientSubBlockSize, coefficientRampSeconds);
+    fadePrecisionCascade.prepare(ps);
+    presetFadeFloat.setSize(numChannels, (int) ps.maximumBlockSize);
+    presetFadeDouble.setSize(numChannels, (int) ps.maximumBlockSize);
+    presetFadeSamples = juce::jmax(1, juce::roundToInt(coefficientRampSeconds * ps.sampleRate));
+    presetFadeRemaining = 0;
+
+    //double: kaskada precyzyjna przy buforze float (take nadprbkowanym),
+    //float: kaskada float przy buforze double oraz wejcie nadprbkowania/liniowej fazy
+    doubleScratch.setSize(numChannels, (int) ps.maximumBlockSize);
+    floatScratch.setSize(numChannels, samplesPerBlock);
+
+    silentSamples = 0;
+    idle = false;
+
+    //aktualizacja filtrw - projekt synchroniczny, wtek audio jeszcze nie dziaa
+    designer.prepare(ps.sampleRate);
+    if (designer.pull())
+        updateAllFilters(designer.getCoefficients());
+    appliedCrossfadeGeneration = designer.getCoefficients().crossfadeGeneration;
+    cascade.reset(); //pierwsze wspczynniki bez interpolacji
+    precisionCascade.reset();
+
+    //liniowa faza zastpuje kaskad (i nadprbkowanie), pierwszy kernel liczony od razu
+    linearPhase.reset();
+    if ((int) parameters.get(ParameterIndex::PhaseMode) == 1)
+    {
+        linearPhase = std::make_unique<LinearPhaseConvolver>();
+        linearPhase->prepare(sampleRate, numChannels, designer.getCoefficients(), ps.sampleRate);
+    }
+
+    if (linearPhase != nullptr)
+        setLatencySamples(linearPhase->getLatencySamples());
+    else
+        setLatencySamples(oversampling != nullptr ? juce::roundToInt(oversampling->getLatencyInSamples()) : 0);
+
+    //obejcie: bez przenikania w toku, linia opniajca dla nowej latencji
+    bypassMix = bypassed ? 0.0 : 1.0;
+    bypassFadeRemaining = 0;
+    dryDelay.setSize(numChannels, getLatencySamples() + samplesPerBlock);
+    dryDelay.clear();
+    dryBlock.setSize(numChannels, samplesPerBlock);
+    dryDelayPosition = 0;
+}
+
+void PJKParametricEQAudioProcessor::handleAsyncUpdate()
+{
+    //host, ktry zapamita getTailLengthSeconds, odczytuje ogon ponownie
+    if (tailChanged.exchange(false))
+        updateHostDisplay(ChangeDetails().withNonParameterStateChanged(true));
+
+    if (preparedSampleRate <= 0)
+        return;
+
+    if ((int) parameters.get(ParameterIndex::Oversampling) == oversamplingFactor
+        && (int) parameters.get(ParameterIndex::OversamplingFilter) == oversamplingFilter
+        && ((int) parameters.get(ParameterIndex::PhaseMode) == 1) == (linearPhase != nullptr))
+        return;
+
+    //processBlock nie jest woany, dopki przetwarzanie jest wstrzymane
+    suspendProcessing(true);
+    prepareProcessing(preparedSampleRate, preparedBlockSize);
+    suspendProcessing(false);
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -135,18 +296,23 @@ bool PJKParametricEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& l
     juce::ignoreUnused (layouts);
     return true;
   #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    //dowolny ukad kanaw (mono, stereo, 5.1, 7.1.4, ambisonia 3. rzdu...) do maxChannels
+    const auto numChannels = layouts.getMainOutputChannelSet().size();
+    if (numChannels < 1 || numChannels > maxChannels)
         return false;
 
     // This checks if the input layout matches the output layout
    #if ! JucePlugin_IsSynth
     if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
         return false;
+
+    //sidechain pasm dynamicznych: wyczony, mono albo stereo
+    if (layouts.inputBuses.size() > 1)
+    {
+        const auto sidechain = layouts.getChannelSet(true, 1);
+        if (!sidechain.isDisabled() && sidechain != juce::AudioChannelSet::mono() && sidechain != juce::AudioChannelSet::stereo())
+            return false;
+    }
    #endif
 
     return true;
@@ -156,10 +322,99 @@ bool PJKParametricEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& l
 
 //Blok przetwarzania
 void PJKParametricEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processWithBypass(buffer, false);
+}
+
+void PJKParametricEQAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processWithBypass(buffer, false);
+}
+
+void PJKParametricEQAudioProcessor::processBlockBypassed (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processWithBypass(buffer, true);
+}
+
+void PJKParametricEQAudioProcessor::processBlockBypassed (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processWithBypass(buffer, true);
+}
+
+//kopiowanie bloku z konwersj typu prbek
+template<typename DestinationType, typename SourceType>
+static void convertBlock(const juce::dsp::AudioBlock<DestinationType>& destination, const juce::dsp::AudioBlock<SourceType>& source)
+{
+    for (size_t channel = 0; channel < source.getNumChannels(); ++channel)
+    {
+        const auto* input = source.getChannelPointer(channel);
+        std::transform(input, input + source.getNumSamples(), destination.getChannelPointer(channel),
+            [](SourceType sample) { return (DestinationType) sample; });
+    }
+}
+
+//kaskada liczy w swojej precyzji; blok innego typu przechodzi przez bufor pomocniczy
+template<typename CascadeType, typename SampleType>
+static void processInPrecision(BiquadCascade<CascadeType>& cascade, juce::AudioBuffer<CascadeType>& scratch,
+    juce::dsp::AudioBlock<SampleType>& block)
+{
+    if (!cascade.hasActiveSections())
+        return;
+
+    if constexpr (std::is_same_v<CascadeType, SampleType>)
+    {
+        cascade.process(juce::dsp::ProcessContextReplacing<SampleType>(block));
+    }
+    else
+    {
+        auto scratchBlock = juce::dsp::AudioBlock<CascadeType>(scratch)
+            .getSubsetChannelBlock(0, block.getNumChannels()).getSubBlock(0, block.getNumSamples());
+        convertBlock(scratchBlock, block);
+        cascade.process(juce::dsp::ProcessContextReplacing<CascadeType>(scratchBlock));
+        convertBlock(block, scratchBlock);
+    }
+}
+
+//indeks ostatniej prbki powyej progu we wszystkich kanaach, -1 dla cichego bloku
+template<typename SampleType>
+static int findLastAudibleSample(const juce::dsp::AudioBlock<SampleType>& block, SampleType threshold)
+{
+    int last = -1;
+    for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+    {
+        const auto* samples = block.getChannelPointer(channel);
+        for (int i = (int) block.getNumSamples() - 1; i > last; --i)
+        {
+            if (std::abs(samples[i]) > threshold)
+            {
+                last = i;
+                break;
+            }
+        }
+    }
+    return last;
+}
+
+//wejcie i stan filtrw byy ciche duej ni ogon - zerowanie stanu raz, przy wejciu w cisz
+void PJKParametricEQAudioProcessor::enterIdle()
+{
+    idle = true;
+    cascade.reset();
+    precisionCascade.reset();
+    presetFadeRemaining = 0;
+    if (oversampling != nullptr)
+        oversampling->reset();
+    if (linearPhase != nullptr)
+        linearPhase->reset();
+    dynamicBands.reset();
+}
+
+template<typename SampleType>
+void PJKParametricEQAudioProcessor::processSamples(juce::AudioBuffer<SampleType>& buffer)
 {
     juce::ScopedNoDenormals noDenormals;
-    auto totalNumInputChannels  = getTotalNumInputChannels();
-    auto totalNumOutputChannels = getTotalNumOutputChannels();
+    auto totalNumInputChannels  = getMainBusNumInputChannels();
+    auto totalNumOutputChannels = getMainBusNumOutputChannels();
 
     // In case we have more outputs than inputs, this code clears any output
     // channels that didn't contain input data, (because these aren't
@@ -170,48 +425,348 @@ void PJKParametricEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
-    updateAllFilters();
+    //offline (render, przetwarzanie wsadowe) projekt od razu w tym wtku - wynik nie zaley od czasu
+    if (isNonRealtime())
+        designer.designPending();
+
+    //nowe wspczynniki tylko gdy wtek projektujcy co opublikowa
+    if (designer.pull())
+    {
+        //zmiana presetu albo trybu kanaw: dotychczasowy tor ze stanem przechodzi do fadeCascade
+        //(zamiana bez alokacji), nowy startuje od razu z docelowymi wspczynnikami; liniowa faza
+        //przenika kernel sama. Przejcie L/R <-> M/S zmienia znaczenie stanu filtrw, wic bez
+        //przenikania byby to skok na wyjciu
+        const auto generation = designer.getCoefficients().crossfadeGeneration;
+        const auto presetChanged = generation != appliedCrossfadeGeneration;
+        appliedCrossfadeGeneration = generation;
+        const auto channelModeChanged = (int) parameters.get(ParameterIndex::ChannelMode) != appliedChannelMode;
+        const auto crossfade = (presetChanged || channelModeChanged) && linearPhase == nullptr;
+        if (crossfade)
+        {
+            std::swap(cascade, fadeCascade);
+            std::swap(precisionCascade, fadePrecisionCascade);
+        }
+
+        updateAllFilters(designer.getCoefficients());
+
+        if (crossfade)
+        {
+            cascade.reset();
+            precisionCascade.reset();
+            presetFadeRemaining = presetFadeSamples;
+        }
+
+        if (linearPhase != nullptr)
+            linearPhase->setCoefficients(designer.getCoefficients(), getProcessingSampleRate());
+    }
     
-    //blok przejmuje bufor
-    juce::dsp::AudioBlock<float> block(buffer);
+    //blok przejmuje kanay wejciowe bufora (szyna sidechain ley za nimi)
+    auto block = juce::dsp::AudioBlock<SampleType>(buffer).getSubsetChannelBlock(0, (size_t) totalNumInputChannels);
+    const auto numSamples = (int) block.getNumSamples();
+
+    //cay blok cichy, a poprzednia prbka powyej progu dalej ni ogon: wyjcie byoby zerowe,
+    //wic tylko zerowanie. Stan jest wtedy zerowy, dlatego blok z powrotem sygnau liczony w caoci
+    //daje ten sam wynik co tor, ktry cay czas pracowa - wznowienie jest co do prbki
+    const auto lastAudible = findLastAudibleSample(block, (SampleType) silenceThreshold);
+    const auto wasSilentLongEnough = silentSamples >= getTailSamples();
+    silentSamples = lastAudible < 0 ? juce::jmin(silentSamples + numSamples, std::numeric_limits<int>::max() / 2)
+                                    : numSamples - 1 - lastAudible;
+
+    if (lastAudible < 0 && wasSilentLongEnough)
+    {
+        if (!idle)
+            enterIdle();
+
+        block.clear();
+        outputMeter.processSilence(numSamples);
+        if (spectrumTap.isEnabled())
+        {
+            spectrumTap.push(SpectrumTap::Pre, block);
+            spectrumTap.push(SpectrumTap::Post, block);
+        }
+        return;
+    }
+    idle = false;
 
-    //kontekst przetwarzania przejmuje blok
-    juce::dsp::ProcessContextReplacing<float> leftContext(block.getSingleChannelBlock(0)); //lewy
-    juce::dsp::ProcessContextReplacing<float> rightContext(block.getSingleChannelBlock(1)); //prawy
+    //pasma dynamiczne - detektory na sygnale przed korekcj albo na szynie sidechain
+    updateDynamicBands();
+    if (dynamicBands.isActive())
+    {
+        const auto sidechainChannels = getBusCount(true) > 1 ? getChannelCountOfBus(true, 1) : 0;
+        if (sidechainChannels > 0)
+        {
+            const auto sidechain = juce::dsp::AudioBlock<SampleType>(buffer)
+                .getSubsetChannelBlock((size_t) getChannelIndexInProcessBlockBuffer(true, 1, 0), (size_t) sidechainChannels);
+            dynamicBands.analyse(block, &sidechain);
+        }
+        else
+        {
+            dynamicBands.analyse(block, nullptr);
+        }
+    }
+
+    //analizator: przy zamknitym edytorze tylko odczyt flagi
+    const auto analyse = spectrumTap.isEnabled();
+    if (analyse)
+        spectrumTap.push(SpectrumTap::Pre, block);
 
-    //przetwarzanie kontekstu
-    leftChain.process(leftContext);
-    rightChain.process(rightContext);
+    processFilters(block);
     
-    //wzmocnienie kocowe
-    gain.setGainDecibels(getSettings(state).gain);
-    gain.process(leftContext);
-    gain.process(rightContext);
-
-    //miernik RMS
-   leftRMSLevel.skip(buffer.getNumSamples());
-    rightRMSLevel.skip(buffer.getNumSamples());
-
-    const auto leftLevel = juce::Decibels::gainToDecibels(buffer.getRMSLevel(0, 0, buffer.getNumSamples()));
-    if (leftLevel < leftRMSLevel.getCurrentValue())
-        leftRMSLevel.setTargetValue(leftLevel);
-    else
-        leftRMSLevel.setCurrentAndTargetValue(leftLevel);
+    //wzmocnienie kocowe i wszystkie mierniki w jednym przejciu
+    outputMeter.setGainDecibels(parameters.get(ParameterIndex::Gain));
+    outputMeter.process(block);
+
+    if (analyse)
+        spectrumTap.push(SpectrumTap::Post, block);
+}
+
+//zapis bloku do linii opniajcej i (readDelayed) odczyt prbek sprzed latencji do dryBlock
+template<typename SampleType>
+void PJKParametricEQAudioProcessor::delayDry(const juce::dsp::AudioBlock<SampleType>& block, bool readDelayed)
+{
+    const auto numSamples = (int) block.getNumSamples();
+    const auto length = dryDelay.getNumSamples();
+    const auto readPosition = (dryDelayPosition + length - getLatencySamples()) % length;
+    jassert(numSamples <= dryBlock.getNumSamples());
 
-    const auto rightLevel = juce::Decibels::gainToDecibels(buffer.getRMSLevel(1, 0, buffer.getNumSamples()));
-    if (rightLevel < rightRMSLevel.getCurrentValue())
-        rightRMSLevel.setTargetValue(rightLevel);
+    for (int channel = 0; channel < (int) block.getNumChannels(); ++channel)
+    {
+        const auto* input = block.getChannelPointer((size_t) channel);
+        auto* delay = dryDelay.getWritePointer(channel);
+        for (int i = 0, position = dryDelayPosition; i < numSamples; ++i, position = (position + 1) % length)
+            delay[position] = (double) input[i];
+
+        if (readDelayed)
+        {
+            auto* dry = dryBlock.getWritePointer(channel);
+            for (int i = 0, position = readPosition; i < numSamples; ++i, position = (position + 1) % length)
+                dry[i] = delay[position];
+        }
+    }
+
+    dryDelayPosition = (dryDelayPosition + numSamples) % length;
+}
+
+//Zmiana obejcia (parametru wtyczki w hocie) przenika tor z sygnaem suchym przez coefficientRampSeconds.
+//Stae obejcie nie liczy filtrw - przy zerowej latencji nie robi nic, inaczej tylko opnia sygna;
+//stan filtrw jest wtedy wyzerowany, wic powrt zaczyna od czystego toru rozgrzewanego w trakcie przenikania
+template<typename SampleType>
+void PJKParametricEQAudioProcessor::processWithBypass(juce::AudioBuffer<SampleType>& buffer, bool shouldBypass)
+{
+    if (shouldBypass != bypassed)
+    {
+        bypassed = shouldBypass;
+        bypassFadeRemaining = juce::jmax(1, juce::roundToInt(coefficientRampSeconds * getSampleRate()));
+        bypassMixStep = ((bypassed ? 0.0 : 1.0) - bypassMix) / bypassFadeRemaining;
+    }
+
+    const auto numChannels = getMainBusNumInputChannels();
+    const auto block = juce::dsp::AudioBlock<SampleType>(buffer).getSubsetChannelBlock(0, (size_t) numChannels);
+    const auto latency = getLatencySamples();
+
+    if (bypassFadeRemaining == 0)
+    {
+        if (bypassed)
+        {
+            if (latency > 0)
+            {
+                delayDry(block, true);
+                convertBlock(block, juce::dsp::AudioBlock<double>(dryBlock).getSubBlock(0, block.getNumSamples()));
+            }
+            for (auto i = numChannels; i < getTotalNumOutputChannels(); ++i)
+                buffer.clear(i, 0, buffer.getNumSamples());
+        }
+        else
+        {
+            //linia opniajca musi by aktualna w chwili wczenia obejcia
+            if (latency > 0)
+                delayDry(block, false);
+            processSamples(buffer);
+        }
+        return;
+    }
+
+    delayDry(block, true);
+    processSamples(buffer);
+
+    const auto numSamples = juce::jmin((int) block.getNumSamples(), bypassFadeRemaining);
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* output = block.getChannelPointer((size_t) channel);
+        const auto* dry = dryBlock.getReadPointer(channel);
+        auto mix = bypassMix;
+        for (int i = 0; i < numSamples; ++i, mix += bypassMixStep)
+            output[i] = (SampleType) (dry[i] + (output[i] - dry[i]) * mix);
+
+        //reszta bloku po kocu przenikania: obejcie - sygna suchy, powrt - tor bez zmian
+        if (bypassed)
+            for (int i = numSamples; i < (int) block.getNumSamples(); ++i)
+                output[i] = (SampleType) dry[i];
+    }
+
+    bypassMix += bypassMixStep * numSamples;
+    bypassFadeRemaining -= numSamples;
+
+    if (bypassFadeRemaining == 0)
+    {
+        bypassMix = bypassed ? 0.0 : 1.0;
+        if (bypassed)
+            enterIdle();
+    }
+}
+
+//przetwarzanie kontekstu, przy nadprbkowaniu na bloku o wyszej czstotliwoci
+void PJKParametricEQAudioProcessor::processFilters(juce::dsp::AudioBlock<float>& block)
+{
+    if (linearPhase != nullptr)
+    {
+        linearPhase->process(block);
+    }
+    else if (oversampling != nullptr)
+    {
+        auto oversampledBlock = oversampling->processSamplesUp(block);
+        processCascades(oversampledBlock);
+        oversampling->processSamplesDown(block);
+    }
     else
-        rightRMSLevel.setCurrentAndTargetValue(rightLevel);
+    {
+        processCascades(block);
+    }
+}
+
+//liniowa faza i nadprbkowanie pracuj w float - blok double przechodzi przez floatScratch,
+//kaskada precyzyjna nadal liczy w double
+void PJKParametricEQAudioProcessor::processFilters(juce::dsp::AudioBlock<double>& block)
+{
+    if (linearPhase == nullptr && oversampling == nullptr)
+    {
+        processCascades(block);
+        return;
+    }
+
+    auto floatBlock = juce::dsp::AudioBlock<float>(floatScratch)
+        .getSubsetChannelBlock(0, block.getNumChannels()).getSubBlock(0, block.getNumSamples());
+    convertBlock(floatBlock, block);
+    processFilters(floatBlock);
+    convertBlock(block, floatBlock);
+}
+
+//zmiana presetu albo trybu kanaw: poprzedni tor liczony na kopii bloku, wynik przechodzi liniowo w nowy tor;
+//poza przenikaniem tylko biece kaskady
+template<typename SampleType>
+void PJKParametricEQAudioProcessor::processCascades(juce::dsp::AudioBlock<SampleType>& block)
+{
+    if (presetFadeRemaining == 0)
+    {
+        processCurrentCascades(block);
+        return;
+    }
+
+    auto previous = juce::dsp::AudioBlock<SampleType>(getPresetFadeBuffer<SampleType>())
+        .getSubsetChannelBlock(0, block.getNumChannels()).getSubBlock(0, block.getNumSamples());
+    convertBlock(previous, block);
+    processInPrecision(fadeCascade, floatScratch, previous);
+    processInPrecision(fadePrecisionCascade, doubleScratch, previous);
+
+    processCurrentCascades(block);
+
+    //reszta bloku po kocu przenikania to ju tylko nowy tor
+    const auto numSamples = juce::jmin((int) block.getNumSamples(), presetFadeRemaining);
+    const auto done = presetFadeSamples - presetFadeRemaining;
+    for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+    {
+        auto* output = block.getChannelPointer(channel);
+        const auto* old = previous.getChannelPointer(channel);
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto mix = (SampleType) (done + i + 1) / (SampleType) presetFadeSamples;
+            output[i] = old[i] + (output[i] - old[i]) * mix;
+        }
+    }
+    presetFadeRemaining -= numSamples;
+}
+
+//sekcje s liniowe i niezmienne w czasie, wic kolejno kaskad nie ma znaczenia
+template<typename SampleType>
+void PJKParametricEQAudioProcessor::processCurrentCascades(juce::dsp::AudioBlock<SampleType>& block)
+{
+    if (!dynamicBands.isActive())
+    {
+        processInPrecision(cascade, floatScratch, block);
+        processInPrecision(precisionCascade, doubleScratch, block);
+        return;
+    }
+
+    //pasma dynamiczne: nowe wspczynniki przed kadym podblokiem detektora (po nadprbkowaniu duszym)
+    const auto subBlockLength = (size_t) coefficientSubBlockSize << oversamplingFactor.load();
+    for (size_t start = 0, subBlock = 0; start < block.getNumSamples(); start += subBlockLength, ++subBlock)
+    {
+        applyDynamicGains((int) subBlock);
+
+        auto part = block.getSubBlock(start, juce::jmin(subBlockLength, block.getNumSamples() - start));
+        processInPrecision(cascade, floatScratch, part);
+        processInPrecision(precisionCascade, doubleScratch, part);
+    }
 }
+
+static_assert(DynamicBands::numBands == maxBands, "");
+
+//pasma wyczone albo niedynamiczne - jeden odczyt parametru, bez aktualizacji detektora
+void PJKParametricEQAudioProcessor::updateDynamicBands()
+{
+    for (int index = 0; index < maxBands; ++index)
+    {
+        auto get = [this, index](BandParameter parameter) { return parameters.get(getBandParameter(index, parameter)); };
+
+        const auto dynamic = get(BandDynamic) > 0.5f && get(BandOff) < 0.5f;
+        const auto wasDynamic = dynamicBands.isDynamic(index);
+        if (!dynamic && !wasDynamic)
+            continue;
+
+        DynamicBands::Band band;
+        band.dynamic = dynamic;
+        band.threshold = get(BandThreshold);
+        band.ratio = get(BandRatio);
+        band.attack = get(BandAttack);
+        band.release = get(BandRelease);
+        band.sidechain = get(BandSidechain) > 0.5f;
+        band.frequency = get(BandFreq);
+        band.gain = get(BandGain);
+        band.quality = get(BandQuality);
+        band.filterType = (int) get(BandType);
+
+        //pasmo przestao by dynamiczne - wraca do wspczynnikw statycznych z wtku projektujcego
+        dynamicBands.setBand(index, band);
+        if (wasDynamic && !band.dynamic)
+            designer.markDirty(1 << (Positions::Filter1 + index));
+    }
+}
+
+//wspczynniki pasm dynamicznych dla podbloku, w kaskadzie, do ktrej trafia sekcja
+void PJKParametricEQAudioProcessor::applyDynamicGains(int subBlock)
+{
+    const auto sampleRate = getProcessingSampleRate();
+
+    for (int index = 0; index < DynamicBands::numBands; ++index)
+    {
+        const auto section = ChainCoefficients::firstBandSection + index;
+        SectionCoefficients coefficients;
+
+        if (!dynamicBands.isDynamic(index) || !sectionActive[(size_t) section]
+            || !dynamicBands.designSection(index, dynamicBands.getGainChange(subBlock, index), sampleRate, coefficients))
+            continue;
+
+        if (sectionInDouble[(size_t) section])
+            precisionCascade.setSectionCoefficients(section, coefficients);
+        else
+            cascade.setSectionCoefficients(section, coefficients);
+    }
+}
+
 //getter do miernika
 float PJKParametricEQAudioProcessor::getRMSValue(const int channel) const
 {
-    if (channel == 0)
-        return leftRMSLevel.getCurrentValue();
-    if (channel == 1)
-        return rightRMSLevel.getCurrentValue();
-    return 0.f;
+    return outputMeter.getRMS(channel);
 }
 
 //==============================================================================
@@ -234,62 +789,165 @@ void PJKParametricEQAudioProcessor::getStateInformation (juce::MemoryBlock& dest
     // You should use this method to store your parameters in the memory block.
     // You could do that either as raw data, or use the XML or ValueTree classes
     // as intermediaries to make it easy to save and load complex data.
-    juce::MemoryOutputStream stream(destData, true);
-    state.state.writeToStream(stream);
+    //zwarty zapis binarny (StateFormat); dawne drzewo ValueTree jest dalej czytane w setStateInformation
+    std::array<float, NumParameters> values;
+    for (int i = 0; i < NumParameters; ++i)
+        values[(size_t) i] = parameters.get((ParameterIndex) i);
+    StateFormat::write(values.data(), NumParameters, destData);
 }
 
 void PJKParametricEQAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
     // You should use this method to restore your parameters from this memory block,
     // whose contents will have been created by the getStateInformation() call.
+    std::array<float, NumParameters> values;
+    const auto numValues = StateFormat::read(data, (size_t) juce::jmax(0, sizeInBytes), values.data(), NumParameters);
+    if (numValues > 0)
+    {
+        setParameterValues(values.data(), numValues);
+        return;
+    }
+
+    //zapis sprzed formatu binarnego
     auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
     if(tree.isValid())
     {
         state.replaceState(tree);
-        updateAllFilters();
+        designer.markDirtyAndWake(CoefficientDesigner::allPositions);
     }
 }
 
-//wczytywanie ustawie parametrw do struktury
-Settings getSettings(juce::AudioProcessorValueTreeState& state)
+//wartoci w kolejnoci ParameterIndex (indeks parametru w procesorze); parametry spoza tablicy
+//i wartoci nieskoczone wracaj do domylnych, niezmienione parametry s pomijane.
+//Zmiany s zbierane przy wstrzymanym projekcie, a host i APVTS dostaj je ju bez blokady
+//projektu (host moe z wntrza setValueNotifyingHost woa procesor albo czeka na swoje blokady).
+//parameterValueChanged nic wtedy nie robi - wersja, maska zmian i przebudowa toru s ustawiane
+//raz, po wszystkich parametrach
+void PJKParametricEQAudioProcessor::setParameterValues(const float* values, int numValues, bool crossfade)
 {
-    Settings settings;
-    settings.highPassFreq = state.getRawParameterValue("HighPass Freq")->load();
-    settings.highPassSlope = state.getRawParameterValue("HighPass Slope")->load();
+    std::array<std::pair<juce::RangedAudioParameter*, float>, NumParameters> changes;
+    int numChanges = 0;
+    bool rebuild = false;
 
-    settings.filter1Type = state.getRawParameterValue("Filter1 Type")->load();
-    settings.filter1Freq = state.getRawParameterValue("Filter1 Freq")->load();
-    settings.filter1Gain = state.getRawParameterValue("Filter1 Gain")->load();
-    settings.filter1Quality = state.getRawParameterValue("Filter1 Quality")->load();
+    designer.beginBatch();
 
-    settings.filter2Type = state.getRawParameterValue("Filter2 Type")->load();
-    settings.filter2Freq = state.getRawParameterValue("Filter2 Freq")->load();
-    settings.filter2Gain = state.getRawParameterValue("Filter2 Gain")->load();
-    settings.filter2Quality = state.getRawParameterValue("Filter2 Quality")->load();
+    const auto& all = getParameters();
+    for (int i = 0; i < NumParameters; ++i)
+    {
+        auto* parameter = static_cast<juce::RangedAudioParameter*>(all.getUnchecked(i));
+        const auto normalised = i < numValues && std::isfinite(values[i]) ? parameter->convertTo0to1(values[i])
+                                                                           : parameter->getDefaultValue();
+        if (normalised == parameter->getValue())
+            continue;
+
+        changes[(size_t) numChanges++] = { parameter, normalised };
+        rebuild = rebuild || i == ParameterIndex::Oversampling || i == ParameterIndex::OversamplingFilter
+                          || i == ParameterIndex::PhaseMode;
+    }
+
+    settingParameterValues = true;
+    for (int i = 0; i < numChanges; ++i)
+        changes[(size_t) i].first->setValueNotifyingHost(changes[(size_t) i].second);
+    settingParameterValues = false;
+
+    parameters.bumpVersion();
+    designer.endBatch(crossfade);
+
+    if (rebuild)
+        triggerAsyncUpdate();
+}
 
-    settings.filter3Type = state.getRawParameterValue("Filter3 Type")->load();
-    settings.filter3Freq = state.getRawParameterValue("Filter3 Freq")->load();
-    settings.filter3Gain = state.getRawParameterValue("Filter3 Gain")->load();
-    settings.filter3Quality = state.getRawParameterValue("Filter3 Quality")->load();
+bool findBandParameter(int parameterIndex, int& band, BandParameter& parameter)
+{
+    //odwrotno getBandParameter; -1 dla parametrw globalnych
+    static const auto locations = []
+    {
+        std::array<int, NumParameters> table;
+        table.fill(-1);
+        for (int b = 0; b < maxBands; ++b)
+            for (int p = 0; p < NumBandParameters; ++p)
+                table[getBandParameter(b, (BandParameter) p)] = b * NumBandParameters + p;
+        return table;
+    }();
+
+    if (parameterIndex < 0 || parameterIndex >= NumParameters || locations[parameterIndex] < 0)
+        return false;
 
-    settings.filter4Type = state.getRawParameterValue("Filter4 Type")->load();
-    settings.filter4Freq = state.getRawParameterValue("Filter4 Freq")->load();
-    settings.filter4Gain = state.getRawParameterValue("Filter4 Gain")->load();
-    settings.filter4Quality = state.getRawParameterValue("Filter4 Quality")->load();
+    band = locations[parameterIndex] / NumBandParameters;
+    parameter = (BandParameter) (locations[parameterIndex] % NumBandParameters);
+    return true;
+}
 
+juce::String getParameterID(int parameterIndex)
+{
+    static const char* const bandIDs[NumBandParameters]
+    {
+        "Freq", "Gain", "Quality", "Type", "Off",
+        "Dynamic", "Threshold", "Ratio", "Attack", "Release", "Sidechain",
+        "Channel"
+    };
 
-    settings.lowPassFreq = state.getRawParameterValue("LowPass Freq")->load();
-    settings.lowPassSlope = state.getRawParameterValue("LowPass Slope")->load();
+    int band;
+    BandParameter parameter;
+    if (findBandParameter(parameterIndex, band, parameter))
+        return "Filter" + juce::String(band + 1) + " " + bandIDs[parameter];
 
-    settings.gain = state.getRawParameterValue("Gain")->load();
+    switch (parameterIndex)
+    {
+    case HighPassFreq:          return "HighPass Freq";
+    case HighPassSlope:         return "HighPass Slope";
+    case LowPassFreq:           return "LowPass Freq";
+    case LowPassSlope:          return "LowPass Slope";
+    case Gain:                  return "Gain";
+    case HighPassOff:           return "HighPass Off";
+    case LowPassOff:            return "LowPass Off";
+    case Oversampling:          return "Oversampling";
+    case OversamplingFilter:    return "Oversampling Filter";
+    case PhaseMode:             return "Phase Mode";
+    case Precision:             return "Precision";
+    case ChannelMode:           return "Channel Mode";
+    default:                    jassertfalse; return {};
+    }
+}
 
-    settings.highPassOff = state.getRawParameterValue("HighPass Off")->load();
-    settings.lowPassOff = state.getRawParameterValue("LowPass Off")->load();
-    settings.filter1Off = state.getRawParameterValue("Filter1 Off")->load();
-    settings.filter2Off = state.getRawParameterValue("Filter2 Off")->load();
-    settings.filter3Off = state.getRawParameterValue("Filter3 Off")->load();
-    settings.filter4Off = state.getRawParameterValue("Filter4 Off")->load();
+ParameterTable::ParameterTable(juce::AudioProcessorValueTreeState& state)
+{
+    for (int i = 0; i < NumParameters; ++i)
+    {
+        const auto id = getParameterID(i);
+        values[i] = state.getRawParameterValue(id);
+        jassert(values[i] != nullptr);
+        //indeks w enumie musi si zgadza z indeksem parametru w procesorze
+        jassert(state.getParameter(id)->getParameterIndex() == i);
+    }
+}
 
+//wczytywanie ustawie parametrw do struktury
+Settings getSettings(const ParameterTable& parameters)
+{
+    Settings settings;
+    settings.version = parameters.getVersion();
+
+    settings.highPassFreq = parameters.get(HighPassFreq);
+    settings.highPassSlope = (int) parameters.get(HighPassSlope);
+
+    for (int index = 0; index < maxBands; ++index)
+    {
+        auto& band = settings.bands[(size_t) index];
+        band.type = (int) parameters.get(getBandParameter(index, BandType));
+        band.freq = parameters.get(getBandParameter(index, BandFreq));
+        band.gain = parameters.get(getBandParameter(index, BandGain));
+        band.quality = parameters.get(getBandParameter(index, BandQuality));
+        band.off = parameters.get(getBandParameter(index, BandOff)) > 0.5f;
+    }
+
+    settings.lowPassFreq = parameters.get(LowPassFreq);
+    settings.lowPassSlope = (int) parameters.get(LowPassSlope);
+
+    settings.gain = parameters.get(Gain);
+
+    settings.highPassOff = parameters.get(HighPassOff) > 0.5f;
+    settings.lowPassOff = parameters.get(LowPassOff) > 0.5f;
     return settings;
 }
 
@@ -301,157 +959,315 @@ void updateCoefficients(Filter::CoefficientsPtr& before, const Filter::Coefficie
     *before = *after;
 }
 
-Filter::CoefficientsPtr createFilters1_4(const Settings& settings, double sampleRate, int filterID)
+SectionCoefficients toSectionCoefficients(const Filter::CoefficientsPtr& coefficients)
 {
-    switch (filterID)
-    {
-    case 0:
+    jassert(coefficients->coefficients.size() == 5);
+    auto* raw = coefficients->getRawCoefficients();
+    return { raw[0], raw[1], raw[2], raw[3], raw[4] };
+}
+
+SectionCoefficients toSectionCoefficients(const juce::dsp::IIR::Coefficients<double>::Ptr& coefficients)
+{
+    jassert(coefficients->coefficients.size() == 5);
+    auto* raw = coefficients->getRawCoefficients();
+    return { raw[0], raw[1], raw[2], raw[3], raw[4] };
+}
+
+template<typename SampleType>
+typename juce::dsp::IIR::Coefficients<SampleType>::Ptr createBandFilter(const BandSettings& band, double sampleRate)
+{
+    const auto gainFactor = juce::Decibels::decibelsToGain((SampleType) band.gain);
+    switch (band.type)
     {
-        switch (settings.filter1Type)
-        {
-        case 0:
-            return juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRate,
-                settings.filter1Freq, settings.filter1Quality,
-                juce::Decibels::decibelsToGain(settings.filter1Gain)); break;
-        case 1:
-            return juce::dsp::IIR::Coefficients<float>::makeLowShelf(sampleRate,
-                settings.filter1Freq, settings.filter1Quality,
-                juce::Decibels::decibelsToGain(settings.filter1Gain)); break;
-        case 2:
-            return juce::dsp::IIR::Coefficients<float>::makeHighShelf(sampleRate,
-                settings.filter1Freq, settings.filter1Quality,
-                juce::Decibels::decibelsToGain(settings.filter1Gain)); break;
-        default:
-            break;
-        }break;
-    }
     case 1:
-    {
-        switch (settings.filter2Type)
-        {
-        case 0:
-            return juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRate,
-                settings.filter2Freq, settings.filter2Quality,
-                juce::Decibels::decibelsToGain(settings.filter2Gain)); break;
-        case 1:
-            return juce::dsp::IIR::Coefficients<float>::makeLowShelf(sampleRate,
-                settings.filter2Freq, settings.filter2Quality,
-                juce::Decibels::decibelsToGain(settings.filter2Gain)); break;
-        case 2:
-            return juce::dsp::IIR::Coefficients<float>::makeHighShelf(sampleRate,
-                settings.filter2Freq, settings.filter2Quality,
-                juce::Decibels::decibelsToGain(settings.filter2Gain)); break;
-        default:
-            break;
-        }break;
-    }
+        return juce::dsp::IIR::Coefficients<SampleType>::makeLowShelf(sampleRate, band.freq, band.quality, gainFactor);
     case 2:
+        return juce::dsp::IIR::Coefficients<SampleType>::makeHighShelf(sampleRate, band.freq, band.quality, gainFactor);
+    default:
+        return juce::dsp::IIR::Coefficients<SampleType>::makePeakFilter(sampleRate, band.freq, band.quality, gainFactor);
+    }
+}
+
+template juce::dsp::IIR::Coefficients<float>::Ptr createBandFilter<float>(const BandSettings&, double);
+template juce::dsp::IIR::Coefficients<double>::Ptr createBandFilter<double>(const BandSettings&, double);
+
+
+//bieguny blisko z = 1 (niska czstotliwo wzgldem fs, zwaszcza przy wysokim Q): w float
+//stan traci precyzj, co sycha jako szum i dryf DC. Miar jest A(1) = 1 + a1 + a2 = |1 - p|^2,
+//prg 1e-3 odpowiada ok. 240 Hz przy 48 kHz.
+static bool needsDoublePrecision(const SectionCoefficients& coefficients)
+{
+    return 1.0 + coefficients.a1 + coefficients.a2 < 1.0e-3;
+}
+
+//Channel Mode: 0 - stereo (wszystkie pasma na wszystkich kanaach), 1 - L/R, 2 - M/S.
+//W trybach L/R i M/S FilterN Channel kieruje pasmo na oba kanay, pierwszy (L / M) albo drugi (R / S);
+//grno- i dolnoprzepustowy zawsze na wszystkich kanaach. Komplet ustawie pasm jest jeden dla
+//wszystkich trybw (zmiana trybu nie przecza pasm) - osobne pasma dla L/R albo M/S to pasma
+//skierowane na jeden kana; komplet na tryb potroiby parametry 24 pasm
+SectionChannels PJKParametricEQAudioProcessor::getSectionChannels(int section) const
+{
+    const auto band = section - ChainCoefficients::firstBandSection;
+    if (appliedChannelMode == 0 || !juce::isPositiveAndBelow(band, maxBands))
+        return SectionChannels::All;
+
+    return (SectionChannels) (int) parameters.get(getBandParameter(band, BandChannel));
+}
+
+//czas opadania odpowiedzi sekcji do -120 dB w prbkach: bieguny z^2 + a1 z + a2, |p|^n = 10^-6
+static double getDecaySamples(const SectionCoefficients& coefficients, double maxSamples)
+{
+    const auto a1 = coefficients.a1, a2 = coefficients.a2;
+    const auto discriminant = a1 * a1 - 4.0 * a2;
+    const auto radius = discriminant < 0.0 ? std::sqrt(a2)
+                                           : juce::jmax(std::abs(-a1 + std::sqrt(discriminant)), std::abs(-a1 - std::sqrt(discriminant))) * 0.5;
+
+    if (radius <= 1.0e-6)
+        return 2.0; //FIR
+    if (radius >= 1.0)
+        return maxSamples;
+
+    return juce::jmin(maxSamples, std::log(1.0e-6) / std::log(radius));
+}
+
+//kolejno sekcji w kaskadzie: HP 0-3, pasma, LP 0-3
+//Precision: 0 - float, 1 - double, 2 - auto (double tylko dla sekcji, ktre tego wymagaj);
+//wczenie i wyczenie sekcji (take przeniesienie midzy kaskadami) to przenikanie w kaskadzie
+void PJKParametricEQAudioProcessor::updateAllFilters(const ChainCoefficients& coefficients)
+{
+    const auto precision = (int) parameters.get(ParameterIndex::Precision);
+    appliedChannelMode = (int) parameters.get(ParameterIndex::ChannelMode);
+    const auto midSide = appliedChannelMode == 2;
+
+    //kodowanie M/S w obu kaskadach - kada przechodzi L/R -> M/S -> L/R
+    cascade.setMidSide(midSide);
+    precisionCascade.setMidSide(midSide);
+
+    for (int i = 0; i < ChainCoefficients::numSections; ++i)
     {
-        switch (settings.filter3Type)
-        {
-        case 0:
-            return juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRate,
-                settings.filter3Freq, settings.filter3Quality,
-                juce::Decibels::decibelsToGain(settings.filter3Gain)); break;
-        case 1:
-            return juce::dsp::IIR::Coefficients<float>::makeLowShelf(sampleRate,
-                settings.filter3Freq, settings.filter3Quality,
-                juce::Decibels::decibelsToGain(settings.filter3Gain)); break;
-        case 2:
-            return juce::dsp::IIR::Coefficients<float>::makeHighShelf(sampleRate,
-                settings.filter3Freq, settings.filter3Quality,
-                juce::Decibels::decibelsToGain(settings.filter3Gain)); break;
-        default:
-            break;
-        }break;
+        const auto& section = coefficients.getSection(i);
+        const bool useDouble = precision == 1 || (precision == 2 && needsDoublePrecision(section));
+        const auto channels = getSectionChannels(i);
+
+        cascade.setSectionTarget(i, section, coefficients.isActive(i) && !useDouble, channels);
+        precisionCascade.setSectionTarget(i, section, coefficients.isActive(i) && useDouble, channels);
+
+        sectionActive[(size_t) i] = coefficients.isActive(i);
+        sectionInDouble[(size_t) i] = useDouble;
     }
-    case 3:
+
+    cascade.commitSections();
+    precisionCascade.commitSections();
+
+    //statyczne wspczynniki nadpisay pasma dynamiczne
+    dynamicBands.invalidate();
+
+    filterTailSeconds.store(coefficients.tailSeconds, std::memory_order_relaxed);
+}
+
+//sekcja toru, ktrej dotyczy parametr
+int getPositionMask(int parameterIndex)
+{
+    //parametry pasma: dynamiczne nie zmieniaj wspczynnikw statycznych
+    int band;
+    BandParameter parameter;
+    if (findBandParameter(parameterIndex, band, parameter))
     {
-        switch (settings.filter4Type)
+        switch (parameter)
         {
-        case 0:
-            return juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRate,
-                settings.filter4Freq, settings.filter4Quality,
-                juce::Decibels::decibelsToGain(settings.filter4Gain)); break;
-        case 1:
-            return juce::dsp::IIR::Coefficients<float>::makeLowShelf(sampleRate,
-                settings.filter4Freq, settings.filter4Quality,
-                juce::Decibels::decibelsToGain(settings.filter4Gain)); break;
-        case 2:
-            return juce::dsp::IIR::Coefficients<float>::makeHighShelf(sampleRate,
-                settings.filter4Freq, settings.filter4Quality,
-                juce::Decibels::decibelsToGain(settings.filter4Gain)); break;
+        case BandFreq: case BandGain: case BandQuality: case BandType: case BandOff: case BandChannel:
+            return 1 << (Positions::Filter1 + band);
         default:
-            break;
-        }break;
+            return 0;
+        }
     }
+
+    switch (parameterIndex)
+    {
+    case HighPassFreq: case HighPassSlope: case HighPassOff:
+        return 1 << Positions::HighPass;
+    case LowPassFreq: case LowPassSlope: case LowPassOff:
+        return 1 << Positions::LowPass;
+    case Precision: //wspczynniki bez zmian, ale sekcje trzeba rozdzieli midzy kaskady na nowo
+    case ChannelMode:
+        return CoefficientDesigner::allPositions;
     default:
-        break;
+        return 0;
     }
-    
-    
 }
 
+//zmiana parametru - oznaczenie sekcji do ponownego zaprojektowania
+void PJKParametricEQAudioProcessor::parameterValueChanged(int parameterIndex, float newValue)
+{
+    //setParameterValues zgasza zmian caoci po ostatnim parametrze
+    if (settingParameterValues)
+        return;
+
+    //automatyzacja hosta przychodzi w wtku audio - tam tylko maska, bez blokady zdarzenia;
+    //zmiana z interfejsu budzi wtek projektu od razu
+    parameters.bumpVersion();
+    if (juce::MessageManager::existsAndIsCurrentThread())
+        designer.markDirtyAndWake(getPositionMask(parameterIndex));
+    else
+        designer.markDirty(getPositionMask(parameterIndex));
 
-void PJKParametricEQAudioProcessor::updateFilters1_4(const Settings& settings)
-{
-    auto filter1Coeff = createFilters1_4(settings, getSampleRate(), 0);
-    auto filter2Coeff = createFilters1_4(settings, getSampleRate(), 1);
-    auto filter3Coeff = createFilters1_4(settings, getSampleRate(), 2);
-    auto filter4Coeff = createFilters1_4(settings, getSampleRate(), 3);
-
-    //przyciski do wczania filtrw
-    leftChain.setBypassed<Positions::Filter1>(settings.filter1Off);
-    rightChain.setBypassed<Positions::Filter1>(settings.filter1Off);
-    leftChain.setBypassed<Positions::Filter2>(settings.filter2Off);
-    rightChain.setBypassed<Positions::Filter2>(settings.filter2Off);
-    leftChain.setBypassed<Positions::Filter3>(settings.filter3Off);
-    rightChain.setBypassed<Positions::Filter3>(settings.filter3Off);
-    leftChain.setBypassed<Positions::Filter4>(settings.filter4Off);
-    rightChain.setBypassed<Positions::Filter4>(settings.filter4Off);
-
-    updateCoefficients(leftChain.get<Positions::Filter1>().coefficients, filter1Coeff);
-    updateCoefficients(rightChain.get<Positions::Filter1>().coefficients, filter1Coeff);
-    updateCoefficients(leftChain.get<Positions::Filter2>().coefficients, filter2Coeff);
-    updateCoefficients(rightChain.get<Positions::Filter2>().coefficients, filter2Coeff);
-    updateCoefficients(leftChain.get<Positions::Filter3>().coefficients, filter3Coeff);
-    updateCoefficients(rightChain.get<Positions::Filter3>().coefficients, filter3Coeff);
-    updateCoefficients(leftChain.get<Positions::Filter4>().coefficients, filter4Coeff);
-    updateCoefficients(rightChain.get<Positions::Filter4>().coefficients, filter4Coeff);
-    
+    if (parameterIndex == ParameterIndex::Oversampling || parameterIndex == ParameterIndex::OversamplingFilter
+        || parameterIndex == ParameterIndex::PhaseMode)
+        triggerAsyncUpdate();
 }
-void PJKParametricEQAudioProcessor::updateHighPass(const Settings& settings)
+
+//==============================================================================
+//wtek projektujcy wspczynniki
+CoefficientDesigner::CoefficientDesigner(const ParameterTable& p)
+    : juce::Thread("Coefficient Designer"), parameters(p)
 {
-    auto highPassCoeff = juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(getSettings(state).highPassFreq, getSampleRate(), 2 * (getSettings(state).highPassSlope + 1));
+}
 
-    auto& leftHighPass = leftChain.get<Positions::HighPass>();
-    auto& rightHighPass = rightChain.get<Positions::HighPass>();
+CoefficientDesigner::~CoefficientDesigner()
+{
+    stopThread(1000);
+}
 
-    leftChain.setBypassed<Positions::HighPass>(settings.highPassOff);
-    rightChain.setBypassed<Positions::HighPass>(settings.highPassOff);
+void CoefficientDesigner::prepare(double newSampleRate)
+{
+    {
+        const juce::ScopedLock sl(lock);
+        sampleRate = newSampleRate;
+    }
+    markDirty(allPositions);
+    designPending();
 
-    updatePassFilter(leftHighPass, highPassCoeff, getSettings(state).highPassSlope);
-    updatePassFilter(rightHighPass, highPassCoeff, getSettings(state).highPassSlope);
-    
+    if (!isThreadRunning())
+        startThread();
 }
-void PJKParametricEQAudioProcessor::updateLowPass(const Settings& settings)
+
+void CoefficientDesigner::designPending()
 {
-    auto lowPassCoeff = juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(getSettings(state).lowPassFreq, getSampleRate(), 2 * (getSettings(state).lowPassSlope + 1));
+    const juce::ScopedLock sl(lock);
+
+    //bez czstotliwoci prbkowania zmiany czekaj na prepare, a w trakcie zmiany wielu
+    //parametrw na endBatch
+    if (sampleRate <= 0 || batchDepth.load() > 0)
+        return;
+
+    const auto changed = dirty.exchange(0);
+    if (changed == 0)
+        return;
 
-    auto& leftLowPass = leftChain.get<Positions::LowPass>();
-    auto& rightLowPass = rightChain.get<Positions::LowPass>();
+    const auto start = juce::Time::getHighResolutionTicks();
+    const auto settings = getSettings(parameters);
 
-    leftChain.setBypassed<Positions::LowPass>(settings.lowPassOff);
-    rightChain.setBypassed<Positions::LowPass>(settings.lowPassOff);
+    //projekty ze wsplnej pamici podrcznej, nowe wartoci projektowane i zapamitywane
+    if (changed & (1 << Positions::HighPass))
+    {
+        const auto designed = getSections(CoefficientCache::makePassKey(CoefficientCache::HighPass, settings.highPassFreq, settings.highPassSlope, sampleRate));
+        for (int i = 0; i < designed.numSections; ++i)
+            working.highPass[i] = designed.sections[i];
+        working.highPassSlope = settings.highPassSlope;
+        working.highPassOff = settings.highPassOff;
+    }
 
-    updatePassFilter(leftLowPass, lowPassCoeff, getSettings(state).lowPassSlope);
-    updatePassFilter(rightLowPass, lowPassCoeff, getSettings(state).lowPassSlope);
+    for (int index = 0; index < maxBands; ++index)
+    {
+        if (changed & (1 << (Positions::Filter1 + index)))
+        {
+            const auto& band = settings.bands[(size_t) index];
+            //wyczone pasmo nie jest projektowane - wspczynniki dostanie przy wczeniu
+            if (!band.off)
+                working.filters[(size_t) index] = getSections(CoefficientCache::makeBandKey(band.type, band.freq,
+                    band.quality, band.gain, sampleRate)).sections[0];
+            working.filtersOff[(size_t) index] = band.off;
+        }
+    }
+
+    if (changed & (1 << Positions::LowPass))
+    {
+        const auto designed = getSections(CoefficientCache::makePassKey(CoefficientCache::LowPass, settings.lowPassFreq, settings.lowPassSlope, sampleRate));
+        for (int i = 0; i < designed.numSections; ++i)
+            working.lowPass[i] = designed.sections[i];
+        working.lowPassSlope = settings.lowPassSlope;
+        working.lowPassOff = settings.lowPassOff;
+    }
+
+    working.sampleRate = sampleRate;
+
+    //ogon kaskady: suma ogonw sekcji (splot odpowiedzi wydua si o dugo kadej z nich),
+    //liczony dla wspczynnikw statycznych - pasma dynamiczne zmieniaj tylko wzmocnienie
+    const auto maxSamples = maxTailSeconds * sampleRate;
+    double tail = 0;
+    for (int i = 0; i < ChainCoefficients::numSections; ++i)
+        if (working.isActive(i))
+            tail += getDecaySamples(working.getSection(i), maxSamples);
+    working.tailSeconds = juce::jmin(tail, maxSamples) / sampleRate;
+
+    if (std::abs(working.tailSeconds - reportedTailSeconds) > juce::jmax(minTailChangeSeconds, tailChangeRatio * reportedTailSeconds))
+    {
+        reportedTailSeconds = working.tailSeconds;
+        if (onTailChanged != nullptr)
+            onTailChanged();
+    }
+    working.crossfadeGeneration = crossfadeGeneration.load(std::memory_order_acquire);
+
+    //publikacja gotowego kompletu dla wtku audio i dla wykresu
+    exchange.getWriteBuffer() = working;
+    exchange.publish();
+    display.getWriteBuffer() = working;
+    display.publish();
+
+    designPasses.fetch_add(1, std::memory_order_relaxed);
+    designTicks.fetch_add(juce::Time::getHighResolutionTicks() - start, std::memory_order_relaxed);
 }
-void PJKParametricEQAudioProcessor::updateAllFilters()
+
+CoefficientCache::Sections CoefficientDesigner::getSections(const CoefficientCache::Key& key)
+{
+    bool wasDesigned;
+    const auto sections = cache->getOrDesign(key, wasDesigned);
+    sectionsRequested.fetch_add(1, std::memory_order_relaxed);
+    if (wasDesigned)
+        sectionsDesigned.fetch_add(1, std::memory_order_relaxed);
+    return sections;
+}
+
+CoefficientDesigner::Statistics CoefficientDesigner::getStatistics() const
+{
+    Statistics statistics;
+    statistics.designPasses = designPasses.load(std::memory_order_relaxed);
+    statistics.sectionsRequested = sectionsRequested.load(std::memory_order_relaxed);
+    statistics.sectionsDesigned = sectionsDesigned.load(std::memory_order_relaxed);
+    statistics.designSeconds = juce::Time::highResolutionTicksToSeconds(designTicks.load(std::memory_order_relaxed));
+    statistics.sharedBytes = cache->getMemoryBytes();
+    statistics.sharingInstances = cache.getReferenceCount();
+    return statistics;
+}
+
+void CoefficientDesigner::beginBatch()
 {
-    updateHighPass(getSettings(state));
-    updateFilters1_4(getSettings(state));
-    updateLowPass(getSettings(state));
+    //blokada czeka na koniec projektu, ktry mg ju czyta parametry
+    const juce::ScopedLock sl(lock);
+    batchDepth.fetch_add(1);
+}
+
+void CoefficientDesigner::endBatch(bool crossfade)
+{
+    if (crossfade)
+        crossfadeGeneration.fetch_add(1, std::memory_order_release);
+
+    //najpierw koniec wstrzymania, potem sygna; endBatch nie jest woane z wtku audio
+    batchDepth.fetch_sub(1);
+    markDirtyAndWake(allPositions);
+}
+
+void CoefficientDesigner::run()
+{
+    //markDirtyAndWake budzi wtek od razu (sygna nie ginie, gdy przyjdzie w trakcie projektu);
+    //markDirty z wtku audio nie sygnalizuje, wic sen jest ograniczony do designIntervalMs
+    while (!threadShouldExit())
+    {
+        if (dirty.load() != 0)
+            designPending();
+
+        wait(designIntervalMs);
+    }
 }
 
 //Layout parametrw
@@ -463,46 +1279,104 @@ juce::AudioProcessorValueTreeState::ParameterLayout PJKParametricEQAudioProcesso
     juce::StringArray filterTypes = {"Peak","Low Shelf","High Shelf"};
     juce::StringArray slopes = {"12 dB/oct","24 dB/oct","36 dB/oct","48 dB/oct"};
     
+    //parametr o danym indeksie - layout jest budowany w kolejnoci ParameterIndex,
+    //wic dawne indeksy 0-59 i pasma dopisane na kocu zgadzaj si z enumem
     //funkcja dodawania parametru (ID, nazwa, zakres(d, gra, krok, skala), domylna)
-    //HighPass
-    layout.add(std::make_unique<juce::AudioParameterFloat>("HighPass Freq", "HighPass Freq", 
-        juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f), 20.f));
-    layout.add(std::make_unique <juce::AudioParameterChoice>("HighPass Slope", "HighPass Slope", slopes, 0));
-
-    //LowPass
-    layout.add(std::make_unique<juce::AudioParameterFloat>("LowPass Freq", "LowPass Freq", juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f), 20000.f));
-    layout.add(std::make_unique<juce::AudioParameterChoice>("LowPass Slope", "LowPass Slope", slopes, 0));
-
-    //Filtry 1-4
-    layout.add(std::make_unique<juce::AudioParameterFloat>("Filter1 Freq", "Filter1 Freq", juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f), 100.f));
-    layout.add(std::make_unique<juce::AudioParameterFloat>("Filter1 Gain", "Filter1 Gain", juce::NormalisableRange<float>(-20.f, 20.f, 0.1f, 1.f), 0.0f));
-    layout.add(std::make_unique<juce::AudioParameterFloat>("Filter1 Quality", "Filter1 Quality", juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 0.5f), 1.f));
-    layout.add(std::make_unique<juce::AudioParameterChoice>("Filter1 Type", "Filter1 Type", filterTypes, 0));
-    
-    layout.add(std::make_unique<juce::AudioParameterFloat>("Filter2 Freq", "Filter2 Freq", juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f), 500.f));
-    layout.add(std::make_unique<juce::AudioParameterFloat>("Filter2 Gain", "Filter2 Gain", juce::NormalisableRange<float>(-20.f, 20.f, 0.1f, 1.f), 0.0f));
-    layout.add(std::make_unique<juce::AudioParameterFloat>("Filter2 Quality", "Filter2 Quality", juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 0.5f), 1.f));
-    layout.add(std::make_unique<juce::AudioParameterChoice>("Filter2 Type", "Filter2 Type", filterTypes, 0));
-
-    layout.add(std::make_unique<juce::AudioParameterFloat>("Filter3 Freq", "Filter3 Freq", juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f), 1000.f));
-    layout.add(std::make_unique<juce::AudioParameterFloat>("Filter3 Gain", "Filter3 Gain", juce::NormalisableRange<float>(-20.f, 20.f, 0.1f, 1.f), 0.0f));
-    layout.add(std::make_unique<juce::AudioParameterFloat>("Filter3 Quality", "Filter3 Quality", juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 0.5f), 1.f));
-    layout.add(std::make_unique<juce::AudioParameterChoice>("Filter3 Type", "Filter3 Type", filterTypes, 0));
-
-    layout.add(std::make_unique<juce::AudioParameterFloat>("Filter4 Freq", "Filter4 Freq", juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f), 5000.f));
-    layout.add(std::make_unique<juce::AudioParameterFloat>("Filter4 Gain", "Filter4 Gain", juce::NormalisableRange<float>(-20.f, 20.f, 0.1f, 1.f), 0.0f));
-    layout.add(std::make_unique<juce::AudioParameterFloat>("Filter4 Quality", "Filter4 Quality", juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 0.5f), 1.f));
-    layout.add(std::make_unique<juce::AudioParameterChoice>("Filter4 Type", "Filter4 Type", filterTypes, 0));
-
-    //Wzmocnienie wyjciowe
-    layout.add(std::make_unique<juce::AudioParameterFloat>("Gain", "Gain", juce::NormalisableRange<float>(-40.f, 20.f, 0.1f, 1.f), 0.0f));
-
-    layout.add(std::make_unique<juce::AudioParameterBool>("HighPass Off", "HighPass Off", true));
-    layout.add(std::make_unique<juce::AudioParameterBool>("LowPass Off", "LowPass Off", true));
-    layout.add(std::make_unique<juce::AudioParameterBool>("Filter1 Off", "Filter1 Off", false));
-    layout.add(std::make_unique<juce::AudioParameterBool>("Filter2 Off", "Filter2 Off", false));
-    layout.add(std::make_unique<juce::AudioParameterBool>("Filter3 Off", "Filter3 Off", false));
-    layout.add(std::make_unique<juce::AudioParameterBool>("Filter4 Off", "Filter4 Off", false));
+    auto createBandParameter = [&](int band, BandParameter parameter) -> std::unique_ptr<juce::RangedAudioParameter>
+    {
+        const auto id = getParameterID(getBandParameter(band, parameter));
+
+        //domylnie wczone s pierwsze cztery pasma, jak w dawnym ukadzie
+        const float defaultFrequencies[] = { 100.f, 500.f, 1000.f, 5000.f };
+
+        switch (parameter)
+        {
+        case BandFreq:
+            return std::make_unique<juce::AudioParameterFloat>(id, id, juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
+                band < legacyBands ? defaultFrequencies[band] : (float) (20.0 * std::pow(1000.0, (band + 0.5) / maxBands)));
+        case BandGain:
+            return std::make_unique<juce::AudioParameterFloat>(id, id, juce::NormalisableRange<float>(-20.f, 20.f, 0.1f, 1.f), 0.0f);
+        case BandQuality:
+            return std::make_unique<juce::AudioParameterFloat>(id, id, juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 0.5f), 1.f);
+        case BandType:
+            return std::make_unique<juce::AudioParameterChoice>(id, id, filterTypes, 0);
+        case BandOff:
+            return std::make_unique<juce::AudioParameterBool>(id, id, band >= legacyBands);
+
+        //pasmo dynamiczne: prg (dB), stosunek, atak i zwolnienie (ms), detektor na szynie sidechain
+        case BandDynamic:
+            return std::make_unique<juce::AudioParameterBool>(id, id, false);
+        case BandThreshold:
+            return std::make_unique<juce::AudioParameterFloat>(id, id, juce::NormalisableRange<float>(-60.f, 0.f, 0.1f, 1.f), -20.f);
+        case BandRatio:
+            return std::make_unique<juce::AudioParameterFloat>(id, id, juce::NormalisableRange<float>(1.f, 20.f, 0.1f, 0.5f), 2.f);
+        case BandAttack:
+            return std::make_unique<juce::AudioParameterFloat>(id, id, juce::NormalisableRange<float>(0.1f, 200.f, 0.1f, 0.3f), 10.f);
+        case BandRelease:
+            return std::make_unique<juce::AudioParameterFloat>(id, id, juce::NormalisableRange<float>(5.f, 2000.f, 1.f, 0.3f), 100.f);
+        case BandSidechain:
+            return std::make_unique<juce::AudioParameterBool>(id, id, false);
+
+        //kana pasma w trybach L/R i M/S (liniowa faza stosuje wszystkie pasma do wszystkich kanaw)
+        case BandChannel:
+        default:
+            return std::make_unique<juce::AudioParameterChoice>(id, id, juce::StringArray{ "Both", "Left/Mid", "Right/Side" }, 0);
+        }
+    };
+
+    auto createParameter = [&](int index) -> std::unique_ptr<juce::RangedAudioParameter>
+    {
+        int band;
+        BandParameter parameter;
+        if (findBandParameter(index, band, parameter))
+            return createBandParameter(band, parameter);
+
+        const auto id = getParameterID(index);
+        switch (index)
+        {
+        //HighPass
+        case HighPassFreq:
+            return std::make_unique<juce::AudioParameterFloat>(id, id, juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f), 20.f);
+        case HighPassSlope:
+            return std::make_unique<juce::AudioParameterChoice>(id, id, slopes, 0);
+
+        //LowPass
+        case LowPassFreq:
+            return std::make_unique<juce::AudioParameterFloat>(id, id, juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f), 20000.f);
+        case LowPassSlope:
+            return std::make_unique<juce::AudioParameterChoice>(id, id, slopes, 0);
+
+        //Wzmocnienie wyjciowe
+        case Gain:
+            return std::make_unique<juce::AudioParameterFloat>(id, id, juce::NormalisableRange<float>(-40.f, 20.f, 0.1f, 1.f), 0.0f);
+
+        case HighPassOff:
+        case LowPassOff:
+            return std::make_unique<juce::AudioParameterBool>(id, id, true);
+
+        //nadprbkowanie
+        case Oversampling:
+            return std::make_unique<juce::AudioParameterChoice>(id, id, juce::StringArray{ "Off", "2x", "4x", "8x" }, 0);
+        case OversamplingFilter:
+            return std::make_unique<juce::AudioParameterChoice>(id, id, juce::StringArray{ "Polyphase IIR", "FIR Half-band" }, 0);
+
+        //tryb fazy
+        case PhaseMode:
+            return std::make_unique<juce::AudioParameterChoice>(id, id, juce::StringArray{ "Minimum Phase", "Linear Phase" }, 0);
+
+        //precyzja stanu filtrw
+        case Precision:
+            return std::make_unique<juce::AudioParameterChoice>(id, id, juce::StringArray{ "Float", "Double", "Auto" }, 2);
+
+        //tryb kanaw (przypisanie pasm w FilterN Channel)
+        case ChannelMode:
+        default:
+            return std::make_unique<juce::AudioParameterChoice>(id, id, juce::StringArray{ "Stereo", "Left/Right", "Mid/Side" }, 0);
+        }
+    };
+
+    for (int index = 0; index < NumParameters; ++index)
+        layout.add(createParameter(index));
 
     return layout;
 }
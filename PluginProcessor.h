@@ -9,86 +9,298 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "BiquadCascade.h"
+#include "CoefficientCache.h"
+#include "SpectrumAnalyzer.h"
+#include "OutputMeter.h"
+#include "DynamicBands.h"
+#include "PresetBank.h"
+
+//najwiksza liczba pasm korektora; pasma wyczone (FilterN Off) nie kosztuj nic w torze audio
+inline constexpr int maxBands = 24;
+
+//ustawienia jednego pasma
+struct BandSettings
+{
+    int type{ 0 };
+    float freq{ 0 }, gain{ 0 }, quality{ 1.f };
+    bool off{ true };
+};
 
 //Struktura do przechowania ustawie parametrw
 struct Settings
 {
     float highPassFreq{ 0 }, lowPassFreq{ 0 };
     int highPassSlope{ 0 }, lowPassSlope{ 0 };
-    int filter1Type{ 0 }, filter2Type{ 0 }, filter3Type{ 0 }, filter4Type{ 0 };
-    float filter1Freq{ 0 }, filter1Gain{ 0 }, filter1Quality{ 1.f },
-        filter2Freq{ 0 }, filter2Gain{ 0 }, filter2Quality{ 1.f }, 
-        filter3Freq{ 0 }, filter3Gain{ 0 }, filter3Quality{ 1.f }, 
-        filter4Freq{ 0 }, filter4Gain{ 0 }, filter4Quality{ 1.f };
+    std::array<BandSettings, maxBands> bands;
     float gain{ 0 };
-    bool highPassOff{ true }, lowPassOff{ true },
-        filter1Off{ false }, filter2Off{ false }, filter3Off{ false }, filter4Off{ false };
+    bool highPassOff{ true }, lowPassOff{ true };
+    //wersja parametrw, z ktrej zrobiono migawk
+    juce::uint32 version{ 0 };
 };
 
-//funkcja do wczytywania parametrw z drzewa do struktury
-Settings getSettings(juce::AudioProcessorValueTreeState& state);
+//parametry pasma, w tej kolejnoci powtarzane dla kadego pasma
+enum BandParameter
+{
+    BandFreq, BandGain, BandQuality, BandType, BandOff,
+    BandDynamic, BandThreshold, BandRatio, BandAttack, BandRelease, BandSidechain,
+    BandChannel,
+    NumBandParameters
+};
 
-//aliasy do filtrw i torw przetwarzania
-using Filter = juce::dsp::IIR::Filter<float>;
+//indeksy parametrw - kolejno taka jak w createParameterLayout. Indeksy 0-59 to ukad sprzed
+//tablicy pasm (4 pasma) i nie mog si zmienia: hosty zapisuj automatyk po indeksie.
+//Pasma 5-24 s dopisane za nimi, po NumBandParameters dla pasma w kolejnoci BandParameter.
+inline constexpr int legacyBands = 4;
 
-using HLPassFilter = juce::dsp::ProcessorChain<Filter, Filter, Filter, Filter>;
+enum ParameterIndex
+{
+    HighPassFreq = 0, HighPassSlope, LowPassFreq, LowPassSlope,
+    //4-19: Freq, Gain, Quality, Type pasm 1-4
+    Gain = 20, HighPassOff, LowPassOff,
+    //23-26: Off pasm 1-4
+    Oversampling = 27, OversamplingFilter, PhaseMode, Precision,
+    //31-54: Dynamic, Threshold, Ratio, Attack, Release, Sidechain pasm 1-4
+    ChannelMode = 55,
+    //56-59: Channel pasm 1-4
+    FirstAppendedBandParameter = 60,
+    NumParameters = FirstAppendedBandParameter + (maxBands - legacyBands) * NumBandParameters
+};
 
-using Chain = juce::dsp::ProcessorChain<HLPassFilter, Filter, Filter, Filter, Filter, HLPassFilter>;
+//pooenie parametrw pasm 1-4 w dawnym ukadzie: indeks = first + band * stride
+struct LegacyBandLocation
+{
+    int first, stride;
+};
 
-enum Positions
+inline constexpr LegacyBandLocation legacyBandLocations[NumBandParameters]
 {
-    HighPass, Filter1, Filter2, Filter3, Filter4, LowPass
+    { 4, 4 }, { 5, 4 }, { 6, 4 }, { 7, 4 },
+    { 23, 1 },
+    { 31, 6 }, { 32, 6 }, { 33, 6 }, { 34, 6 }, { 35, 6 }, { 36, 6 },
+    { 56, 1 }
 };
 
-void updateCoefficients(Filter::CoefficientsPtr& before, const Filter::CoefficientsPtr& after);
+//indeks parametru pasma (band od 0)
+constexpr ParameterIndex getBandParameter(int band, BandParameter parameter)
+{
+    if (band < legacyBands)
+        return (ParameterIndex) (legacyBandLocations[parameter].first + band * legacyBandLocations[parameter].stride);
+
+    return (ParameterIndex) (FirstAppendedBandParameter + (band - legacyBands) * NumBandParameters + parameter);
+}
 
-//filterID: 0, 1, 2, 3; tworzenie filtrw
+//pasmo i parametr pasma dla indeksu; false dla parametrw globalnych
+bool findBandParameter(int parameterIndex, int& band, BandParameter& parameter);
 
-Filter::CoefficientsPtr createFilters1_4(const Settings& settings, double sampleRate, int filterID);
+//ID parametru; pasma maj ID "FilterN Freq" itd. (N od 1), jak przed wprowadzeniem tablicy pasm,
+//wic zapisane sesje i automatyka pasm 1-4 wczytuj si bez zmian
+juce::String getParameterID(int parameterIndex);
 
-template<typename ChainType, typename CoefficientType>
-void updatePassFilter(ChainType& passFilter,
-    const CoefficientType& coeffs,
-    const int& slope)
+//wskaniki do wartoci parametrw wyszukane raz, w konstruktorze - bez szukania po nazwie
+struct ParameterTable
 {
-    //0 - 12 dB/oct, 1 - 24 dB/oct, 2 - 36dB/oct, 3 - 48dB/oct
-    passFilter.template setBypassed<0>(true);
-    passFilter.template setBypassed<1>(true);
-    passFilter.template setBypassed<2>(true);
-    passFilter.template setBypassed<3>(true);
+    ParameterTable(juce::AudioProcessorValueTreeState& state);
+
+    float get(ParameterIndex index) const { return values[index]->load(std::memory_order_relaxed); }
+    //zwikszana przy kadej zmianie parametru
+    juce::uint32 getVersion() const { return version.load(std::memory_order_acquire); }
+    void bumpVersion() { version.fetch_add(1, std::memory_order_acq_rel); }
+
+private:
+    std::array<std::atomic<float>*, NumParameters> values;
+    std::atomic<juce::uint32> version{ 0 };
+};
+
+//funkcja do wczytywania parametrw z tablicy do struktury
+Settings getSettings(const ParameterTable& parameters);
 
-    switch (slope)
+//alias do filtra JUCE (konwersja wspczynnikw)
+using Filter = juce::dsp::IIR::Filter<float>;
+
+//sekcje toru: bity masek zmian w CoefficientDesigner
+enum Positions
+{
+    HighPass, Filter1, LowPass = Filter1 + maxBands
+};
+
+//maska sekcji toru (bity z Positions), ktrej dotyczy parametr
+int getPositionMask(int parameterIndex);
+
+//gotowy komplet wspczynnikw caego toru, przekazywany do wtku audio
+struct ChainCoefficients
+{
+    std::array<SectionCoefficients, 4> highPass, lowPass;
+    std::array<SectionCoefficients, maxBands> filters;
+    int highPassSlope{ 0 }, lowPassSlope{ 0 };
+    bool highPassOff{ true }, lowPassOff{ true };
+    std::array<bool, maxBands> filtersOff{};
+    //czstotliwo, dla ktrej zaprojektowano wspczynniki
+    double sampleRate{ 0 };
+    //ogon samych filtrw (do -120 dB) z promieni biegunw aktywnych sekcji
+    double tailSeconds{ 0 };
+    //numer ostatniej proby o przenikanie (zmiana presetu); komplet o innym numerze ni ostatnio
+    //zastosowany zastpuje poprzedni przez przenikanie obu torw, a nie interpolacj sekcji
+    juce::uint32 crossfadeGeneration{ 0 };
+
+    //sekcje w kolejnoci kaskady: HP 0-3, pasma, LP 0-3
+    static constexpr int firstBandSection = 4, firstLowPassSection = firstBandSection + maxBands;
+    static constexpr int numSections = firstLowPassSection + 4;
+    const SectionCoefficients& getSection(int index) const
     {
-    case 3:
+        return index < firstBandSection ? highPass[index]
+             : index < firstLowPassSection ? filters[index - firstBandSection]
+                                           : lowPass[index - firstLowPassSection];
+    }
+    bool isActive(int index) const
     {
-        updateCoefficients(passFilter.template get<3>().coefficients, coeffs[3]);
-        passFilter.template setBypassed<3>(false);
+        return index < firstBandSection ? !highPassOff && index <= highPassSlope
+             : index < firstLowPassSection ? !filtersOff[index - firstBandSection]
+                                           : !lowPassOff && index - firstLowPassSection <= lowPassSlope;
     }
+};
+static_assert(ChainCoefficients::numSections <= BiquadCascade<float>::maxSections, "");
+
+void updateCoefficients(Filter::CoefficientsPtr& before, const Filter::CoefficientsPtr& after);
+SectionCoefficients toSectionCoefficients(const Filter::CoefficientsPtr& coefficients);
+SectionCoefficients toSectionCoefficients(const juce::dsp::IIR::Coefficients<double>::Ptr& coefficients);
+
+//tworzenie filtra pasma (float dla wykresu, double dla toru audio)
+template<typename SampleType = float>
+typename juce::dsp::IIR::Coefficients<SampleType>::Ptr createBandFilter(const BandSettings& band, double sampleRate);
 
-    case 2:
+//bufor potrjny: jeden wtek publikuje, wtek audio odbiera najnowsz wersj bez blokad
+template<typename T>
+class TripleBuffer
+{
+public:
+    //strona wtku piszcego
+    T& getWriteBuffer() { return buffers[writeIndex]; }
+    void publish()
     {
-        updateCoefficients(passFilter.template get<2>().coefficients, coeffs[2]);
-        passFilter.template setBypassed<2>(false);
+        writeIndex = middle.exchange(writeIndex | newData, std::memory_order_acq_rel) & indexMask;
     }
-    case 1:
+
+    //strona wtku audio, zwraca true gdy s nowe dane
+    bool acquire()
     {
-        updateCoefficients(passFilter.template get<1>().coefficients, coeffs[1]);
-        passFilter.template setBypassed<1>(false);
+        if ((middle.load(std::memory_order_acquire) & newData) == 0)
+            return false;
+
+        readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & indexMask;
+        return true;
     }
-    case 0:
+    bool hasNewData() const { return (middle.load(std::memory_order_acquire) & newData) != 0; }
+    const T& getReadBuffer() const { return buffers[readIndex]; }
+
+    //tylko gdy aden wtek nie korzysta z bufora (np. w prepare)
+    void reset(const T& value)
     {
-        updateCoefficients(passFilter.template get<0>().coefficients, coeffs[0]);
-        passFilter.template setBypassed<0>(false);
+        for (auto& buffer : buffers)
+            buffer = value;
+        middle.fetch_and(indexMask);
     }
-    default:
-        break;
+
+private:
+    static constexpr int indexMask = 3, newData = 4;
+    std::array<T, 3> buffers;
+    int writeIndex{ 0 }, readIndex{ 1 };
+    std::atomic<int> middle{ 2 };
+};
+
+//projektowanie filtrw w osobnym wtku, tylko dla sekcji ktrych parametry si zmieniy
+class CoefficientDesigner : private juce::Thread
+{
+public:
+    CoefficientDesigner(const ParameterTable& p);
+    ~CoefficientDesigner() override;
+
+    //maska bitowa z Positions
+    static constexpr int allPositions = (1 << (Positions::LowPass + 1)) - 1;
+    static constexpr double maxTailSeconds = 10.0;
+
+    //nowa czstotliwo prbkowania - projektuje wszystko od razu i uruchamia wtek
+    void prepare(double newSampleRate);
+    //zatrzymanie wtku przed zniszczeniem waciciela, ktrego woa onTailChanged
+    void stop() { stopThread(1000); }
+    //ogon filtrw zmieni si wyranie od ostatniego zgoszenia; woane w wtku projektu
+    //(offline w wtku audio), ustawiane przed prepare
+    std::function<void()> onTailChanged;
+    //moe by woane z dowolnego wtku, rwnie z wtku audio - samo ustawienie bitw, bez blokad;
+    //wtek projektu zauway je najpniej po designIntervalMs
+    void markDirty(int positionMask) { dirty.fetch_or(positionMask); }
+    //markDirty z natychmiastowym obudzeniem wtku projektu; notify() blokuje muteks zdarzenia,
+    //wic nigdy z wtku audio
+    void markDirtyAndWake(int positionMask)
+    {
+        markDirty(positionMask);
+        notify();
     }
-}
+    //projektuje zalege sekcje w biecym wtku i publikuje wynik
+    void designPending();
+    //zmiana wielu parametrw naraz: od beginBatch (czeka na koniec trwajcego projektu) do endBatch
+    //projekt nie startuje, eby nie zobaczy poowy nowego stanu; endBatch oznacza cay tor,
+    //z prob o przenikanie dla crossfade (zmiana presetu: kolejny numer crossfadeGeneration) -
+    //projekt i tak liczy wtek projektu
+    void beginBatch();
+    void endBatch(bool crossfade);
+
+    //tylko wtek audio
+    bool pull() { return exchange.acquire(); }
+    const ChainCoefficients& getCoefficients() const { return exchange.getReadBuffer(); }
+
+    //tylko wtek wykresu (ResponseWorker) - osobna kopia, eby nie zabiera danych wtkowi audio
+    bool pullDisplay() { return display.acquire(); }
+    const ChainCoefficients& getDisplayCoefficients() const { return display.getReadBuffer(); }
+
+    const CoefficientCache& getCache() const { return *cache; }
+
+    //koszt instancji: czas projektowania, sekcje zaprojektowane przez ni i pobrane ze wsplnej
+    //pamici, pami wsplna (dzielona przez sharingInstances instancji); instanceBytes - pami
+    //caej instancji procesora, wypeniana przez PJKParametricEQAudioProcessor::getDesignStatistics
+    struct Statistics
+    {
+        juce::uint64 designPasses{ 0 }, sectionsRequested{ 0 }, sectionsDesigned{ 0 };
+        double designSeconds{ 0 };
+        size_t instanceBytes{ 0 }, sharedBytes{ 0 };
+        int sharingInstances{ 0 };
+    };
+    Statistics getStatistics() const;
+
+private:
+    void run() override;
+    //sekcje ze wsplnej pamici z liczeniem statystyk
+    CoefficientCache::Sections getSections(const CoefficientCache::Key& key);
+
+    //najdusze opnienie projektu dla zmian, ktre nie budz wtku (automatyzacja w wtku audio)
+    static constexpr int designIntervalMs = 5;
+    //zgaszana zmiana ogona: o ponad 10% i co najmniej o 10 ms
+    static constexpr double tailChangeRatio = 0.1, minTailChangeSeconds = 0.01;
+
+    const ParameterTable& parameters;
+    juce::CriticalSection lock;
+    double sampleRate{ 0 };
+    ChainCoefficients working;
+    double reportedTailSeconds{ 0 };
+    juce::SharedResourcePointer<SharedCoefficientCache> cache;
+    std::atomic<juce::uint64> designPasses{ 0 }, sectionsRequested{ 0 }, sectionsDesigned{ 0 };
+    std::atomic<juce::int64> designTicks{ 0 };
+    std::atomic<int> dirty{ allPositions };
+    std::atomic<int> batchDepth{ 0 };
+    //numer jest tylko zwikszany, wic adna proba nie ginie: ani gdy nowszy komplet zastpi
+    //w buforze potrjnym niepobrany, ani gdy nowa proba przyjdzie w trakcie przenikania poprzedniej
+    std::atomic<juce::uint32> crossfadeGeneration{ 0 };
+    TripleBuffer<ChainCoefficients> exchange, display;
+};
+
+class LinearPhaseConvolver;
 
 //==============================================================================
 /**
 */
-class PJKParametricEQAudioProcessor  : public juce::AudioProcessor
+class PJKParametricEQAudioProcessor  : public juce::AudioProcessor,
+                                       private juce::AudioProcessorParameter::Listener,
+                                       private juce::AsyncUpdater
                             #if JucePlugin_Enable_ARA
                              , public juce::AudioProcessorARAExtension
                             #endif
@@ -107,6 +319,11 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    //obejcie caej wtyczki przez hosta: przenikanie do sygnau suchego opnionego o latencj
+    void processBlockBypassed (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlockBypassed (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -119,6 +336,8 @@ public:
     bool producesMidi() const override;
     bool isMidiEffect() const override;
     double getTailLengthSeconds() const override;
+    //ogon w prbkach (filtry i opnienie) - take dla renderowania offline z kompensacj opnienia
+    int getTailSamples() const;
 
     //==============================================================================
     int getNumPrograms() override;
@@ -130,28 +349,143 @@ public:
     //==============================================================================
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
+    //szybkie ustawienie wszystkich parametrw z tablicy wartoci (odczyt stanu, preset);
+    //crossfade - nowy tor przenikany ze starym zamiast interpolacji sekcji
+    void setParameterValues(const float* values, int numValues, bool crossfade = false);
+
+    //bank presetw widoczny przez programy wtyczki; domylnie plik z getDefaultPresetBankFile
+    bool openPresetBank(const juce::File& file);
+    static juce::File getDefaultPresetBankFile();
      
     //Drzewo parametrw
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout(); //funkcja do tworzenia layoutu
     juce::AudioProcessorValueTreeState state{ *this, nullptr, "Parameters", createParameterLayout() }; //drzewo parametrw
+    ParameterTable parameters{ state }; //szybki dostp do wartoci
     
     //getter do miernika
     float getRMSValue(const int channel) const;
+    //wszystkie mierniki wyjcia - odczyt z dowolnego wtku
+    OutputMeter& getOutputMeter() { return outputMeter; }
+
+    //najwiksza obsugiwana liczba kanaw na szynie
+    static constexpr int maxChannels = OutputMeter::maxChannels;
+
+    //czstotliwo, z jak faktycznie pracuj filtry (z nadprbkowaniem)
+    double getProcessingSampleRate() const { return getSampleRate() * (1 << oversamplingFactor.load()); }
+
+    //statystyki pamici podrcznej projektw filtrw (wsplnej dla procesu) i kosztu tej instancji
+    const CoefficientCache& getCoefficientCache() const { return designer.getCache(); }
+    CoefficientDesigner::Statistics getDesignStatistics() const;
+
+    //migawka wspczynnikw dla wykresu - woane tylko z wtku ResponseWorker
+    bool pullDisplayCoefficients() { return designer.pullDisplay(); }
+    const ChainCoefficients& getDisplayCoefficients() const { return designer.getDisplayCoefficients(); }
+
+    //sygna dla analizatora widma w edytorze
+    SpectrumTap& getSpectrumTap() { return spectrumTap; }
 private:  
-    //tor przetwarzania
-    Chain leftChain, rightChain;
-    //wzmocnienie
-    juce::dsp::Gain<float> gain;
-    
-    void updateHighPass(const Settings& settings);
-    void updateLowPass(const Settings& settings);
+    //tor przetwarzania - wszystkie kanay w jednej kaskadzie SIMD; sekcje, ktre tego wymagaj
+    //(parametr Precision), liczone s w drugiej kaskadzie ze stanem w double
+    BiquadCascade<float> cascade;
+    BiquadCascade<double> precisionCascade;
+    //bufory konwersji, gdy typ bloku nie zgadza si z precyzj kaskady
+    juce::AudioBuffer<float> floatScratch;
+    juce::AudioBuffer<double> doubleScratch;
+    //siatka przeliczania wspczynnikw i czas przejcia przy automatyce
+    static constexpr int coefficientSubBlockSize = 32;
+    static constexpr double coefficientRampSeconds = 0.02;
+
+    //nadprbkowanie - tworzone tylko gdy jest wczone (nullptr = wyczone)
+    std::unique_ptr<juce::dsp::Oversampling<float>> oversampling;
+    std::atomic<int> oversamplingFactor{ 0 }; //log2 krotnoci
+    int oversamplingFilter{ 0 };
+    double preparedSampleRate{ 0 };
+    int preparedBlockSize{ 0 };
+
+    //tryb liniowej fazy - splot z FIR, tworzony tylko gdy jest wczony
+    std::unique_ptr<LinearPhaseConvolver> linearPhase;
+
+    void prepareProcessing(double sampleRate, int samplesPerBlock);
+    //zmiana nadprbkowania lub trybu fazy wymaga alokacji - robiona w wtku wiadomoci
+    void handleAsyncUpdate() override;
+    //wzmocnienie kocowe razem z miernikami wyjcia
+    OutputMeter outputMeter;
 
-    void updateAllFilters();
-   
-    void updateFilters1_4(const Settings& settings);
+    //wsplne przetwarzanie dla buforw float i double
+    template<typename SampleType>
+    void processSamples(juce::AudioBuffer<SampleType>& buffer);
+    void processFilters(juce::dsp::AudioBlock<float>& block);
+    void processFilters(juce::dsp::AudioBlock<double>& block);
+    template<typename SampleType>
+    void processCascades(juce::dsp::AudioBlock<SampleType>& block);
+
+    //wspczynniki projektowane poza wtkiem audio
+    CoefficientDesigner designer{ parameters };
+    void parameterValueChanged(int parameterIndex, float newValue) override;
+    void parameterGestureChanged(int parameterIndex, bool gestureIsStarting) override {}
+
+    void updateAllFilters(const ChainCoefficients& coefficients);
+    //kanay sekcji kaskady wedug Channel Mode i FilterN Channel
+    SectionChannels getSectionChannels(int section) const;
+    //gdzie trafia sekcja w updateAllFilters - pasmo dynamiczne zmienia wspczynniki w tej samej kaskadzie
+    std::array<bool, ChainCoefficients::numSections> sectionActive{}, sectionInDouble{};
+
+    //pasma dynamiczne: detektory na wejciu w rozdzielczoci hosta, zmiana wzmocnienia na podblok
+    DynamicBands dynamicBands;
+    void updateDynamicBands();
+    void applyDynamicGains(int subBlock);
+
+    //odczep przed i po korekcji, aktywny tylko przy otwartym edytorze
+    SpectrumTap spectrumTap;
+
+    //cisza na wejciu dusza ni ogon toru - filtry pomijane, wyjcie i stan wyzerowane
+    static constexpr float silenceThreshold = 1.0e-6f; //-120 dB
+    //ogon filtrw zastosowanych wspczynnikw (ChainCoefficients::tailSeconds); zmian zgasza
+    //hostowi handleAsyncUpdate - hosty czytaj getTailLengthSeconds zwykle tylko po prepareToPlay
+    std::atomic<double> filterTailSeconds{ 0 };
+    std::atomic<bool> tailChanged{ false };
+    int silentSamples{ 0 };
+    bool idle{ false };
+    void enterIdle();
+
+    //obejcie caej wtyczki: waga toru (1 - przetwarzanie, 0 - obejcie) i przenikanie w toku;
+    //po zakoczonym przenikaniu do obejcia filtry nie s liczone, a stan jest wyzerowany
+    bool bypassed{ false };
+    double bypassMix{ 1.0 }, bypassMixStep{ 0.0 };
+    int bypassFadeRemaining{ 0 };
+    //sygna suchy wyrwnany z latencj toru: linia opniajca (latencja + blok) i biecy blok
+    juce::AudioBuffer<double> dryDelay, dryBlock;
+    int dryDelayPosition{ 0 };
+    template<typename SampleType>
+    void processWithBypass(juce::AudioBuffer<SampleType>& buffer, bool shouldBypass);
+    template<typename SampleType>
+    void delayDry(const juce::dsp::AudioBlock<SampleType>& block, bool readDelayed);
+
+    //presety: bank mapowany do pamici, zmiana parametrw bez projektowania pojedynczych sekcji
+    PresetBank presetBank;
+    int currentProgram{ 0 };
+    std::atomic<bool> settingParameterValues{ false };
+    //zmiana presetu albo trybu kanaw: poprzedni tor (ze stanem) liczony rwnolegle do koca przenikania
+    BiquadCascade<float> fadeCascade;
+    BiquadCascade<double> fadePrecisionCascade;
+    juce::AudioBuffer<float> presetFadeFloat;
+    juce::AudioBuffer<double> presetFadeDouble;
+    int presetFadeSamples{ 1 }, presetFadeRemaining{ 0 };
+    //tryb kanaw, dla ktrego ustawiono kaskady (updateAllFilters), i numer ostatnio
+    //zastosowanego przenikania z ChainCoefficients
+    int appliedChannelMode{ 0 };
+    juce::uint32 appliedCrossfadeGeneration{ 0 };
+    template<typename SampleType>
+    juce::AudioBuffer<SampleType>& getPresetFadeBuffer()
+    {
+        if constexpr (std::is_same_v<SampleType, float>)
+            return presetFadeFloat;
+        else
+            return presetFadeDouble;
+    }
+    template<typename SampleType>
+    void processCurrentCascades(juce::dsp::AudioBlock<SampleType>& block);
 
-    //miernik RMS
-    juce::LinearSmoothedValue<float> rightRMSLevel, leftRMSLevel;
     
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PJKParametricEQAudioProcessor)
@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    PresetBank.cpp
+
+  ==============================================================================
+*/
+
+#include "PresetBank.h"
+#include "StateFormat.h"
+
+bool PresetBank::open(const juce::File& file)
+{
+    close();
+
+    auto newMapped = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+    if (newMapped->getData() == nullptr || newMapped->getSize() < sizeof(Header))
+        return false;
+
+    const auto* bytes = static_cast<const char*>(newMapped->getData());
+    const auto bytesSize = newMapped->getSize();
+    const auto count = juce::ByteOrder::littleEndianInt(bytes + 8);
+
+    if (juce::ByteOrder::littleEndianInt(bytes) != magic || juce::ByteOrder::littleEndianInt(bytes + 4) != version
+        || count > (bytesSize - sizeof(Header)) / sizeof(IndexEntry) || count > (juce::uint32) std::numeric_limits<int>::max())
+        return false;
+
+    mapped = std::move(newMapped);
+    data = bytes;
+    size = bytesSize;
+    numPresets = (int) count;
+    return true;
+}
+
+void PresetBank::close()
+{
+    mapped.reset();
+    data = nullptr;
+    size = 0;
+    numPresets = 0;
+}
+
+//uszkodzony wpis nie uniewania banku - preset ma wtedy pust nazw albo si nie wczytuje
+PresetBank::IndexEntry PresetBank::getEntry(int index) const
+{
+    const auto* entry = data + sizeof(Header) + (size_t) index * sizeof(IndexEntry);
+
+    IndexEntry result{ juce::ByteOrder::littleEndianInt(entry), juce::ByteOrder::littleEndianInt(entry + 4),
+                       juce::ByteOrder::littleEndianInt(entry + 8), juce::ByteOrder::littleEndianInt(entry + 12) };
+
+    if ((size_t) result.nameOffset + result.nameSize > size)
+        result.nameOffset = result.nameSize = 0;
+    if ((size_t) result.stateOffset + result.stateSize > size)
+        result.stateOffset = result.stateSize = 0;
+
+    return result;
+}
+
+juce::String PresetBank::getName(int index) const
+{
+    if (!juce::isPositiveAndBelow(index, numPresets))
+        return {};
+
+    const auto entry = getEntry(index);
+    return juce::String::fromUTF8(data + entry.nameOffset, (int) entry.nameSize);
+}
+
+int PresetBank::getValues(int index, float* values, int maxValues) const
+{
+    if (!juce::isPositiveAndBelow(index, numPresets))
+        return 0;
+
+    const auto entry = getEntry(index);
+    return StateFormat::read(data + entry.stateOffset, entry.stateSize, values, maxValues);
+}
+
+bool PresetBank::write(const juce::File& file, const juce::Array<Preset>& presets)
+{
+    //indeks, za nim wszystkie nazwy, potem wszystkie stany
+    std::vector<IndexEntry> entries((size_t) presets.size());
+    auto offset = (juce::uint64) sizeof(Header) + entries.size() * sizeof(IndexEntry);
+
+    for (int i = 0; i < presets.size(); ++i)
+    {
+        entries[(size_t) i].nameOffset = (juce::uint32) offset;
+        entries[(size_t) i].nameSize = (juce::uint32) presets.getReference(i).name.getNumBytesAsUTF8();
+        offset += entries[(size_t) i].nameSize;
+    }
+    for (int i = 0; i < presets.size(); ++i)
+    {
+        entries[(size_t) i].stateOffset = (juce::uint32) offset;
+        entries[(size_t) i].stateSize = (juce::uint32) presets.getReference(i).state.getSize();
+        offset += entries[(size_t) i].stateSize;
+    }
+
+    //przesunicia s 32-bitowe
+    if (offset > std::numeric_limits<juce::uint32>::max())
+        return false;
+
+    juce::TemporaryFile temporary(file);
+    {
+        juce::FileOutputStream stream(temporary.getFile());
+        if (!stream.openedOk())
+            return false;
+
+        //FileOutputStream zapisuje little-endian niezalenie od platformy
+        stream.writeInt((int) magic);
+        stream.writeInt((int) version);
+        stream.writeInt(presets.size());
+        stream.writeInt(0);
+
+        for (const auto& entry : entries)
+        {
+            stream.writeInt((int) entry.nameOffset);
+            stream.writeInt((int) entry.nameSize);
+            stream.writeInt((int) entry.stateOffset);
+            stream.writeInt((int) entry.stateSize);
+        }
+
+        for (const auto& preset : presets)
+            stream.write(preset.name.toRawUTF8(), preset.name.getNumBytesAsUTF8());
+        for (const auto& preset : presets)
+            stream.write(preset.state.getData(), preset.state.getSize());
+
+        stream.flush();
+        if (stream.getStatus().failed())
+            return false;
+    }
+
+    return temporary.overwriteTargetFileWithTemporary();
+}
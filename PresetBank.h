@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    PresetBank.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//Bank presetw w jednym pliku mapowanym do pamici: lista nazw i wczytanie presetu czytaj
+//tylko nagwek, wpis indeksu i dane tego jednego presetu, wic bank moe mie tysice pozycji.
+//Ukad (little-endian): nagwek, indeks (numPresets wpisw staej dugoci), potem dane -
+//nazwy w UTF-8 i stany presetw w formacie StateFormat.
+class PresetBank
+{
+public:
+    struct Preset
+    {
+        juce::String name;
+        juce::MemoryBlock state; //blok z getStateInformation
+    };
+
+    //mapuje plik i sprawdza nagwek oraz rozmiar indeksu; false (i pusty bank), gdy plik jest niepoprawny
+    bool open(const juce::File& file);
+    void close();
+
+    int getNumPresets() const { return numPresets; }
+    juce::String getName(int index) const;
+    //wartoci parametrw presetu (StateFormat::read), 0 dla zego indeksu lub uszkodzonego wpisu
+    int getValues(int index, float* values, int maxValues) const;
+
+    //zapis caego banku (narzdzia, testy); plik otwarty w innym banku trzeba najpierw zamkn
+    static bool write(const juce::File& file, const juce::Array<Preset>& presets);
+
+private:
+    //"PJKB"
+    static constexpr juce::uint32 magic = 0x424b4a50;
+    static constexpr juce::uint32 version = 1;
+
+    struct Header
+    {
+        juce::uint32 magic, version, numPresets, reserved;
+    };
+
+    struct IndexEntry
+    {
+        juce::uint32 nameOffset, nameSize, stateOffset, stateSize;
+    };
+
+    //wpis indeksu; zakresy wychodzce poza plik s zerowane
+    IndexEntry getEntry(int index) const;
+
+    std::unique_ptr<juce::MemoryMappedFile> mapped;
+    const char* data{ nullptr };
+    size_t size{ 0 };
+    int numPresets{ 0 };
+};
@@ -0,0 +1,187 @@
+/*
+  ==============================================================================
+
+    ResponseRenderer.cpp
+
+  ==============================================================================
+*/
+
+#include "ResponseRenderer.h"
+
+bool ResponseRenderer::setGrid(int newNumPixels, double newSampleRate, double newMinFrequency, double newMaxFrequency)
+{
+    if (newNumPixels == numPixels && newSampleRate == sampleRate
+        && newMinFrequency == minFrequency && newMaxFrequency == maxFrequency)
+        return false;
+
+    numPixels = juce::jmax(0, newNumPixels);
+    sampleRate = newSampleRate;
+    minFrequency = newMinFrequency;
+    maxFrequency = newMaxFrequency;
+    numGroups = (numPixels + lanes - 1) / lanes;
+
+    phi.resize((size_t) numGroups);
+    phiSquared.resize((size_t) numGroups);
+    numerator.resize((size_t) numGroups);
+    denominator.resize((size_t) numGroups);
+
+    //piksele poza szerokoci (dopenienie ostatniego rejestru) liczone jak ostatni piksel
+    auto* rawPhi = reinterpret_cast<float*>(phi.data());
+    auto* rawPhiSquared = reinterpret_cast<float*>(phiSquared.data());
+    for (int i = 0; i < numGroups * lanes; ++i)
+    {
+        const auto frequency = juce::mapToLog10((double) juce::jmin(i, numPixels - 1) / (double) numPixels, minFrequency, maxFrequency);
+        const auto halfOmega = juce::MathConstants<double>::pi * frequency / sampleRate;
+        const auto s = std::sin(halfOmega);
+        rawPhi[i] = (float) (s * s);
+        rawPhiSquared[i] = (float) (s * s * s * s);
+    }
+
+    for (int index = 0; index < numSections; ++index)
+    {
+        sectionDecibels[(size_t) index].assign((size_t) numGroups, Register::expand(0.f));
+        if (active[(size_t) index])
+            updateSection(index);
+    }
+
+    decibels.assign((size_t) numPixels, 0.f);
+    curveChanged = true;
+    return true;
+}
+
+bool ResponseRenderer::setSection(int index, const SectionCoefficients& coefficients, bool isActive)
+{
+    auto& section = sections[(size_t) index];
+    const auto sameCoefficients = section.b0 == coefficients.b0 && section.b1 == coefficients.b1 && section.b2 == coefficients.b2
+                               && section.a1 == coefficients.a1 && section.a2 == coefficients.a2;
+
+    if (isActive == active[(size_t) index] && (sameCoefficients || !isActive))
+        return false;
+
+    section = coefficients;
+    active[(size_t) index] = isActive;
+
+    if (isActive && numPixels > 0)
+        updateSection(index);
+
+    curveChanged = true;
+    return true;
+}
+
+//|H|^2 = ((b0+b1+b2)^2 - 4(b0b1 + 4b0b2 + b1b2)phi + 16b0b2 phi^2) / (to samo dla a0 = 1, a1, a2)
+void ResponseRenderer::updateSection(int index)
+{
+    const auto& c = sections[(size_t) index];
+
+    const auto bSum = c.b0 + c.b1 + c.b2, aSum = 1.0 + c.a1 + c.a2;
+    const auto n0 = Register::expand((float) (bSum * bSum));
+    const auto n1 = Register::expand((float) (-4.0 * (c.b0 * c.b1 + 4.0 * c.b0 * c.b2 + c.b1 * c.b2)));
+    const auto n2 = Register::expand((float) (16.0 * c.b0 * c.b2));
+    const auto d0 = Register::expand((float) (aSum * aSum));
+    const auto d1 = Register::expand((float) (-4.0 * (c.a1 + 4.0 * c.a2 + c.a1 * c.a2)));
+    const auto d2 = Register::expand((float) (16.0 * c.a2));
+
+    for (int group = 0; group < numGroups; ++group)
+    {
+        numerator[(size_t) group] = n0 + n1 * phi[(size_t) group] + n2 * phiSquared[(size_t) group];
+        denominator[(size_t) group] = d0 + d1 * phi[(size_t) group] + d2 * phiSquared[(size_t) group];
+    }
+
+    //log10 nie ma odpowiednika w SIMDRegister - ptla skalarna, tylko dla zmienionej sekcji
+    const auto* rawNumerator = reinterpret_cast<const float*>(numerator.data());
+    const auto* rawDenominator = reinterpret_cast<const float*>(denominator.data());
+    auto* result = reinterpret_cast<float*>(sectionDecibels[(size_t) index].data());
+    for (int i = 0; i < numGroups * lanes; ++i)
+        result[i] = 10.f * std::log10(juce::jmax(rawNumerator[i], 1.0e-30f) / juce::jmax(rawDenominator[i], 1.0e-30f));
+}
+
+const std::vector<float>& ResponseRenderer::getDecibels()
+{
+    if (!curveChanged)
+        return decibels;
+
+    //suma aktywnych sekcji, po lanes pikseli naraz (wynik w numerator jako buforze)
+    std::fill(numerator.begin(), numerator.end(), Register::expand(0.f));
+    for (int index = 0; index < numSections; ++index)
+    {
+        if (!active[(size_t) index])
+            continue;
+
+        const auto& section = sectionDecibels[(size_t) index];
+        for (int group = 0; group < numGroups; ++group)
+            numerator[(size_t) group] += section[(size_t) group];
+    }
+
+    const auto* sum = reinterpret_cast<const float*>(numerator.data());
+    std::copy(sum, sum + numPixels, decibels.begin());
+
+    curveChanged = false;
+    pathChanged = true;
+    return decibels;
+}
+
+const juce::Path& ResponseRenderer::getPath(juce::Rectangle<float> bounds, float minDecibels, float maxDecibels)
+{
+    getDecibels();
+
+    if (!pathChanged && bounds == pathBounds && minDecibels == pathMinDecibels && maxDecibels == pathMaxDecibels)
+        return path;
+
+    path.clear();
+    if (numPixels > 0)
+    {
+        path.preallocateSpace(3 * numPixels + 3);
+        const auto step = bounds.getWidth() / (float) numPixels;
+        auto y = [&](float value) { return juce::jmap(value, minDecibels, maxDecibels, bounds.getBottom(), bounds.getY()); };
+
+        path.startNewSubPath(bounds.getX(), y(decibels.front()));
+        for (int i = 1; i < numPixels; ++i)
+            path.lineTo(bounds.getX() + (float) i * step, y(decibels[(size_t) i]));
+    }
+
+    pathBounds = bounds;
+    pathMinDecibels = minDecibels;
+    pathMaxDecibels = maxDecibels;
+    pathChanged = false;
+    return path;
+}
+
+//==============================================================================
+ResponseWorker::ResponseWorker()
+    : juce::Thread("Response Worker")
+{
+}
+
+ResponseWorker::~ResponseWorker()
+{
+    stopThread(1000);
+}
+
+void ResponseWorker::addClient(Client* client)
+{
+    const juce::ScopedLock sl(lock);
+    clients.addIfNotAlreadyThere(client);
+
+    if (!isThreadRunning())
+        startThread();
+}
+
+void ResponseWorker::removeClient(Client* client)
+{
+    const juce::ScopedLock sl(lock);
+    clients.removeFirstMatchingValue(client);
+}
+
+void ResponseWorker::run()
+{
+    while (!threadShouldExit())
+    {
+        {
+            const juce::ScopedLock sl(lock);
+            for (auto* client : clients)
+                client->updateResponse();
+        }
+
+        wait(updateIntervalMs);
+    }
+}
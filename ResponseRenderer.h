@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    ResponseRenderer.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BiquadCascade.h"
+
+//charakterystyka amplitudowa kaskady na siatce pikseli wykresu.
+//Tablice sin^2(w/2) dla kadego piksela liczone raz na rozmiar i czstotliwo prbkowania,
+//charakterystyka kadej sekcji (dB) trzymana osobno - zmiana jednego pasma przelicza tylko
+//jego wektor, a krzywa to suma wektorw aktywnych sekcji. Wielomiany liczone na rejestrach SIMD,
+//posta z sin^2(w/2) nie traci precyzji w float przy niskich czstotliwociach.
+class ResponseRenderer
+{
+public:
+    using Register = juce::dsp::SIMDRegister<float>;
+    static constexpr int lanes = (int) Register::SIMDNumElements;
+    static constexpr int numSections = BiquadCascade<float>::maxSections;
+
+    //siatka log10 od minFrequency do maxFrequency; true, gdy co si zmienio
+    bool setGrid(int numPixels, double sampleRate, double minFrequency = 20.0, double maxFrequency = 20000.0);
+    //przelicza sekcj tylko wtedy, gdy zmieniy si jej wspczynniki lub stan
+    bool setSection(int index, const SectionCoefficients& coefficients, bool isActive);
+
+    int getNumPixels() const { return numPixels; }
+    //suma aktywnych sekcji w dB, odwieana tylko po zmianie
+    const std::vector<float>& getDecibels();
+
+    //cieka krzywej, przebudowywana tylko po zmianie krzywej lub prostokta
+    const juce::Path& getPath(juce::Rectangle<float> bounds, float minDecibels, float maxDecibels);
+
+private:
+    void updateSection(int index);
+
+    int numPixels{ 0 }, numGroups{ 0 };
+    double sampleRate{ 0 }, minFrequency{ 0 }, maxFrequency{ 0 };
+
+    //na piksel: sin^2(w/2) i jego kwadrat, pogrupowane po lanes pikseli
+    std::vector<Register> phi, phiSquared;
+    std::vector<Register> numerator, denominator;
+
+    std::array<SectionCoefficients, numSections> sections;
+    std::array<bool, numSections> active{};
+    std::array<std::vector<Register>, numSections> sectionDecibels;
+
+    std::vector<float> decibels;
+    bool curveChanged{ true }, pathChanged{ true };
+
+    juce::Path path;
+    juce::Rectangle<float> pathBounds;
+    float pathMinDecibels{ 0 }, pathMaxDecibels{ 0 };
+};
+
+//wsplny wtek liczcy krzywe wszystkich otwartych edytorw (przez juce::SharedResourcePointer),
+//koszt wtku wiadomoci nie ronie z liczb instancji
+class ResponseWorker : private juce::Thread
+{
+public:
+    struct Client
+    {
+        virtual ~Client() = default;
+        //wtek roboczy: przelicza i publikuje krzyw, jeli co si zmienio
+        virtual void updateResponse() = 0;
+    };
+
+    ResponseWorker();
+    ~ResponseWorker() override;
+
+    void addClient(Client* client);
+    //po powrocie updateResponse tego klienta na pewno nie jest wykonywane
+    void removeClient(Client* client);
+
+private:
+    void run() override;
+
+    static constexpr int updateIntervalMs = 15;
+
+    juce::CriticalSection lock;
+    juce::Array<Client*> clients;
+};
@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.cpp
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyzer.h"
+
+int SpectrumTap::pull(Point point, float* destination, int numSamples)
+{
+    auto& queue = queues[(size_t) point];
+
+    int start1, size1, start2, size2;
+    queue.fifo.prepareToRead(numSamples, start1, size1, start2, size2);
+
+    std::copy_n(queue.samples.data() + start1, size1, destination);
+    std::copy_n(queue.samples.data() + start2, size2, destination + size1);
+
+    queue.fifo.finishedRead(size1 + size2);
+    return size1 + size2;
+}
+
+void SpectrumTap::skip(Point point, int numSamples)
+{
+    auto& queue = queues[(size_t) point];
+    queue.fifo.finishedRead(juce::jmin(numSamples, queue.fifo.getNumReady()));
+}
+
+//==============================================================================
+SpectrumAnalyzer::SpectrumAnalyzer()
+    : history((size_t) fftSize, 0.f),
+      incoming((size_t) hopSize, 0.f),
+      fftData((size_t) fftSize * 2, 0.f),
+      power((size_t) numBins, 0.f)
+{
+}
+
+bool SpectrumAnalyzer::setGrid(int newNumPixels, double newSampleRate, double newMinFrequency, double newMaxFrequency)
+{
+    //bez czstotliwoci prbkowania (przed prepareToPlay) nie ma siatki
+    if (newSampleRate <= 0)
+        newNumPixels = 0;
+
+    if (newNumPixels == numPixels && newSampleRate == sampleRate
+        && newMinFrequency == minFrequency && newMaxFrequency == maxFrequency)
+        return false;
+
+    numPixels = juce::jmax(0, newNumPixels);
+    sampleRate = newSampleRate;
+    minFrequency = newMinFrequency;
+    maxFrequency = newMaxFrequency;
+
+    pixelBins.resize((size_t) numPixels);
+    decibels.assign((size_t) numPixels, -120.f);
+
+    //piksel i to czstotliwo i / numPixels na osi log, jak w ResponseRenderer;
+    //obejmuje prki od poowy odlegoci do ssiada z lewej do poowy odlegoci do ssiada z prawej
+    const auto binsPerHz = (double) fftSize / juce::jmax(1.0, sampleRate);
+    auto binAt = [&](double pixel)
+    {
+        return juce::mapToLog10(juce::jlimit(0.0, 1.0, pixel / (double) numPixels), minFrequency, maxFrequency) * binsPerHz;
+    };
+
+    for (int i = 0; i < numPixels; ++i)
+    {
+        auto& bins = pixelBins[(size_t) i];
+        bins.first = juce::jlimit(0, numBins - 1, (int) std::ceil(binAt(i - 0.5)));
+        bins.last = juce::jlimit(-1, numBins - 1, (int) std::floor(binAt(i + 0.5)));
+        bins.position = (float) juce::jlimit(0.0, (double) (numBins - 1), binAt(i));
+    }
+
+    updateDecibels();
+    return true;
+}
+
+bool SpectrumAnalyzer::update(SpectrumTap& tap, SpectrumTap::Point point)
+{
+    const auto backlog = tap.getNumReady(point) - maxBacklog;
+    if (backlog > 0)
+        tap.skip(point, backlog);
+
+    bool changed = false;
+    for (;;)
+    {
+        numIncoming += tap.pull(point, incoming.data() + numIncoming, hopSize - numIncoming);
+        if (numIncoming < hopSize)
+            break;
+
+        //okno przesuwane o hopSize prbek
+        std::copy(history.begin() + hopSize, history.end(), history.begin());
+        std::copy(incoming.begin(), incoming.end(), history.end() - hopSize);
+        numIncoming = 0;
+
+        processFrame();
+        changed = true;
+    }
+
+    if (changed)
+        updateDecibels();
+
+    return changed;
+}
+
+void SpectrumAnalyzer::processFrame()
+{
+    std::copy(history.begin(), history.end(), fftData.begin());
+    window.multiplyWithWindowingTable(fftData.data(), (size_t) fftSize);
+    fft.performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+    //okno znormalizowane (wzmocnienie 1) - sinus o amplitudzie A daje modu A * fftSize / 2
+    const auto scale = 2.f / (float) fftSize;
+    for (int bin = 0; bin < numBins; ++bin)
+    {
+        const auto amplitude = fftData[(size_t) bin] * scale;
+        power[(size_t) bin] += averaging * (amplitude * amplitude - power[(size_t) bin]);
+    }
+}
+
+void SpectrumAnalyzer::updateDecibels()
+{
+    for (int i = 0; i < numPixels; ++i)
+    {
+        const auto& bins = pixelBins[(size_t) i];
+        float value;
+
+        if (bins.last >= bins.first)
+        {
+            value = 0.f;
+            for (int bin = bins.first; bin <= bins.last; ++bin)
+                value = juce::jmax(value, power[(size_t) bin]);
+        }
+        else
+        {
+            const auto bin = (int) bins.position;
+            const auto next = juce::jmin(bin + 1, numBins - 1);
+            const auto fraction = bins.position - (float) bin;
+            value = power[(size_t) bin] + fraction * (power[(size_t) next] - power[(size_t) bin]);
+        }
+
+        decibels[(size_t) i] = 10.f * std::log10(juce::jmax(value, 1.0e-12f));
+    }
+}
+
+void SpectrumAnalyzer::getPath(juce::Path& path, juce::Rectangle<float> bounds, float minDecibels, float maxDecibels) const
+{
+    path.clear();
+    if (numPixels == 0)
+        return;
+
+    path.preallocateSpace(3 * numPixels + 12);
+    const auto step = bounds.getWidth() / (float) numPixels;
+    auto y = [&](float value)
+    {
+        return juce::jmap(juce::jlimit(minDecibels, maxDecibels, value), minDecibels, maxDecibels, bounds.getBottom(), bounds.getY());
+    };
+
+    path.startNewSubPath(bounds.getX(), bounds.getBottom());
+    for (int i = 0; i < numPixels; ++i)
+        path.lineTo(bounds.getX() + (float) i * step, y(decibels[(size_t) i]));
+    path.lineTo(bounds.getX() + (float) (numPixels - 1) * step, bounds.getBottom());
+    path.closeSubPath();
+}
@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//odczep sygnau dla analizatora: kanay urednione do mono, przed korekcj i po niej.
+//Wtek audio tylko dopisuje do kolejek SPSC (juce::AbstractFifo - bez blokad i bez czekania),
+//przy penej kolejce prbki s gubione. Wyczony (zamknity edytor) kosztuje jedno sprawdzenie flagi na blok.
+class SpectrumTap
+{
+public:
+    enum Point
+    {
+        Pre, Post, NumPoints
+    };
+
+    static constexpr int queueSize = 1 << 15;
+
+    //edytor wcza przy otwarciu i wycza przy zamkniciu
+    void setEnabled(bool shouldBeEnabled) { enabled.store(shouldBeEnabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    //czstotliwo hosta - odczep jest przed nadprbkowaniem i po nim
+    void setSampleRate(double newSampleRate) { sampleRate.store(newSampleRate, std::memory_order_relaxed); }
+    double getSampleRate() const { return sampleRate.load(std::memory_order_relaxed); }
+
+    //tylko wtek audio
+    template<typename SampleType>
+    void push(Point point, const juce::dsp::AudioBlock<SampleType>& block);
+
+    //tylko wtek analizy
+    int getNumReady(Point point) const { return queues[(size_t) point].fifo.getNumReady(); }
+    int pull(Point point, float* destination, int numSamples);
+    void skip(Point point, int numSamples);
+
+    //pami kolejek (bez samego obiektu)
+    size_t getMemoryBytes() const { return (size_t) NumPoints * (size_t) queueSize * sizeof(float); }
+
+private:
+    struct Queue
+    {
+        juce::AbstractFifo fifo{ queueSize };
+        std::vector<float> samples = std::vector<float>((size_t) queueSize);
+    };
+
+    std::array<Queue, NumPoints> queues;
+    std::atomic<bool> enabled{ false };
+    std::atomic<double> sampleRate{ 0 };
+};
+
+template<typename SampleType>
+void SpectrumTap::push(Point point, const juce::dsp::AudioBlock<SampleType>& block)
+{
+    auto& queue = queues[(size_t) point];
+    const auto numChannels = (int) block.getNumChannels();
+    if (numChannels == 0)
+        return;
+
+    const auto scale = 1.f / (float) numChannels;
+
+    int start1, size1, start2, size2;
+    queue.fifo.prepareToWrite((int) block.getNumSamples(), start1, size1, start2, size2);
+
+    //bufor kolejki jest piercieniem - zapis w najwyej dwch kawakach
+    auto write = [&](int destination, int offset, int numSamples)
+    {
+        auto* output = queue.samples.data() + destination;
+
+        const auto* first = block.getChannelPointer(0) + offset;
+        for (int i = 0; i < numSamples; ++i)
+            output[i] = (float) first[i] * scale;
+
+        for (int channel = 1; channel < numChannels; ++channel)
+        {
+            const auto* input = block.getChannelPointer((size_t) channel) + offset;
+            for (int i = 0; i < numSamples; ++i)
+                output[i] += (float) input[i] * scale;
+        }
+    };
+
+    write(start1, 0, size1);
+    write(start2, size1, size2);
+    queue.fifo.finishedWrite(size1 + size2);
+}
+
+//widmo jednego punktu odczepu, liczone w wtku ResponseWorker. Okno Hanna, FFT co hopSize prbek
+//(nakadanie 75%), wykadnicze urednianie mocy i grupowanie prkw na siatk pikseli w skali log:
+//piksel obejmujcy kilka prkw to najsilniejszy z nich (szczyty tonw nie gin w redniej),
+//wszy od prka - interpolacja midzy prkami.
+//Bufory alokowane w konstruktorze i przy zmianie siatki, nie przy kadej ramce.
+class SpectrumAnalyzer
+{
+public:
+    static constexpr int fftOrder = 12;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int hopSize = fftSize / 4;
+    static constexpr int numBins = fftSize / 2 + 1;
+
+    SpectrumAnalyzer();
+
+    //siatka jak w ResponseRenderer; true, gdy co si zmienio
+    bool setGrid(int numPixels, double sampleRate, double minFrequency = 20.0, double maxFrequency = 20000.0);
+    //odbiera prbki z kolejki i liczy zalege ramki; true, gdy widmo si zmienio
+    bool update(SpectrumTap& tap, SpectrumTap::Point point);
+
+    //poziom w dBFS na piksel (sinus o penej skali to 0 dB)
+    const std::vector<float>& getDecibels() const { return decibels; }
+    //wypeniony obszar pod widmem, path jest czyszczona i uywana ponownie
+    void getPath(juce::Path& path, juce::Rectangle<float> bounds, float minDecibels, float maxDecibels) const;
+
+private:
+    void processFrame();
+    void updateDecibels();
+
+    //waga nowej ramki w urednianiu
+    static constexpr float averaging = 0.3f;
+    //po przerwie (np. wstrzymany wtek) analizowane s tylko najnowsze prbki
+    static constexpr int maxBacklog = 4 * fftSize;
+
+    juce::dsp::FFT fft{ fftOrder };
+    juce::dsp::WindowingFunction<float> window{ (size_t) fftSize, juce::dsp::WindowingFunction<float>::hann };
+
+    std::vector<float> history, incoming, fftData, power;
+    int numIncoming{ 0 };
+
+    //prki piksela: maksimum z first..last albo, gdy last < first, interpolacja w position
+    struct PixelBins
+    {
+        int first{ 0 }, last{ -1 };
+        float position{ 0 };
+    };
+
+    int numPixels{ 0 };
+    double sampleRate{ 0 }, minFrequency{ 0 }, maxFrequency{ 0 };
+    std::vector<PixelBins> pixelBins;
+    std::vector<float> decibels;
+};
@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    StateFormat.cpp
+
+  ==============================================================================
+*/
+
+#include "StateFormat.h"
+
+void StateFormat::write(const float* values, int numValues, juce::MemoryBlock& destination)
+{
+    jassert(numValues >= 0 && numValues <= 0xffff);
+
+    destination.setSize(sizeof(Header) + (size_t) numValues * sizeof(float));
+    juce::MemoryOutputStream stream(destination, false);
+
+    //MemoryOutputStream zapisuje little-endian niezalenie od platformy
+    stream.writeInt((int) magic);
+    stream.writeShort((short) version);
+    stream.writeShort((short) numValues);
+    for (int i = 0; i < numValues; ++i)
+        stream.writeFloat(values[i]);
+}
+
+int StateFormat::read(const void* data, size_t size, float* values, int maxValues)
+{
+    if (data == nullptr || size < sizeof(Header))
+        return 0;
+
+    const auto* bytes = static_cast<const char*>(data);
+    if (juce::ByteOrder::littleEndianInt(bytes) != magic)
+        return 0;
+
+    const auto dataVersion = juce::ByteOrder::littleEndianShort(bytes + 4);
+    const auto numValues = (int) juce::ByteOrder::littleEndianShort(bytes + 6);
+    if (dataVersion == 0 || dataVersion > version || size < sizeof(Header) + (size_t) numValues * sizeof(float))
+        return 0;
+
+    const auto count = juce::jmin(numValues, maxValues);
+    const auto* payload = bytes + sizeof(Header);
+
+   #if JUCE_LITTLE_ENDIAN
+    std::memcpy(values, payload, (size_t) count * sizeof(float));
+   #else
+    for (int i = 0; i < count; ++i)
+    {
+        const auto bits = juce::ByteOrder::littleEndianInt(payload + i * sizeof(float));
+        std::memcpy(values + i, &bits, sizeof(float));
+    }
+   #endif
+
+    return count;
+}
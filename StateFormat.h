@@ -0,0 +1,38 @@
+/*
+  ==============================================================================
+
+    StateFormat.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//Zwarty zapis stanu wtyczki: nagwek i wartoci parametrw w kolejnoci ParameterIndex
+//(float little-endian, w jednostkach parametru - nie znormalizowane, wic zmiana zakresu
+//parametru nie psuje zapisu). Odczyt to sprawdzenie nagwka i skopiowanie tablicy, bez parsowania.
+//Wersja 1: kolejno ParameterIndex - dawne indeksy 0-59, potem pasma 5-24. Parametry dopisane na kocu nie wymagaj
+//nowej wersji - starszy zapis ma ich mniej i brakujce wracaj do wartoci domylnych;
+//zmiana kolejnoci lub znaczenia wartoci wymaga nowej wersji i mapowania w read().
+namespace StateFormat
+{
+    //"PJKS" - dawny zapis ValueTree zaczyna si nazw typu drzewa ("Parameters")
+    constexpr juce::uint32 magic = 0x534b4a50;
+    constexpr juce::uint16 version = 1;
+
+    struct Header
+    {
+        juce::uint32 magic;
+        juce::uint16 version, numValues;
+    };
+    static_assert(sizeof(Header) == 8, "");
+
+    //zapis numValues wartoci, poprzednia zawarto bloku jest zastpowana
+    void write(const float* values, int numValues, juce::MemoryBlock& destination);
+
+    //liczba wczytanych wartoci (najwyej maxValues); 0, gdy dane nie s w tym formacie
+    //albo pochodz z nowszej wersji
+    int read(const void* data, size_t size, float* values, int maxValues);
+}
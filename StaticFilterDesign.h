@@ -0,0 +1,242 @@
+/*
+  ==============================================================================
+
+    StaticFilterDesign.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "BiquadCascade.h"
+
+//sekcje jednego projektu: HP/LP Butterworth rzdu 2-8 to najwyej 4 sekcje, filtry 1-4 jedna
+struct DesignedSections
+{
+    std::array<SectionCoefficients, 4> sections{};
+    int numSections{ 0 };
+};
+
+//projektowanie bez sterty: wynik w std::array, wszystkie funkcje constexpr, wic dla staej
+//czstotliwoci prbkowania tablice wspczynnikw mona policzy w czasie kompilacji.
+//Wzory i kolejno dziaa jak w juce::dsp::IIR::Coefficients::make* oraz
+//juce::dsp::FilterDesign::designIIR*HighOrderButterworthMethod; funkcje trygonometryczne
+//liczone szeregami (std:: nie jest constexpr w C++17). Rnica wzgldem JUCE w double
+//jest mniejsza ni 1e-12 na znormalizowanym wspczynniku (20 Hz - 0.45 fs, Q 0.1-10, +-20 dB),
+//co sprawdza checkStaticDesigner w Benchmark/Main.cpp.
+namespace StaticFilterDesign
+{
+    namespace Math
+    {
+        constexpr double pi = 3.141592653589793238;
+        constexpr double ln2 = 0.693147180559945309;
+        constexpr double ln10 = 2.302585092994045684;
+
+        constexpr double abs(double x) { return x < 0 ? -x : x; }
+
+        //sprowadzenie do [-pi, pi]
+        constexpr double reduceAngle(double x)
+        {
+            const auto turns = x / (2 * pi);
+            const auto whole = (double) (long long) (turns < 0 ? turns - 0.5 : turns + 0.5);
+            return x - whole * 2 * pi;
+        }
+
+        constexpr double sin(double x)
+        {
+            x = reduceAngle(x);
+            //sin(pi - x) = sin(x), argument szeregu w [-pi/2, pi/2]
+            if (x > pi / 2)
+                x = pi - x;
+            else if (x < -pi / 2)
+                x = -pi - x;
+
+            double term = x, sum = x;
+            for (int n = 1; n < 12; ++n)
+            {
+                term *= -x * x / ((2 * n) * (2 * n + 1));
+                sum += term;
+            }
+            return sum;
+        }
+
+        constexpr double cos(double x)
+        {
+            return sin(x + pi / 2);
+        }
+
+        constexpr double tan(double x)
+        {
+            return sin(x) / cos(x);
+        }
+
+        //metoda Newtona
+        constexpr double sqrt(double x)
+        {
+            if (x <= 0)
+                return 0;
+
+            double y = x > 1 ? x : 1;
+            for (int i = 0; i < 100; ++i)
+            {
+                const auto next = 0.5 * (y + x / y);
+                if (next >= y)
+                    break;
+                y = next;
+            }
+            return y;
+        }
+
+        //e^x = 2^k * e^r, |r| <= ln2 / 2
+        constexpr double exp(double x)
+        {
+            const auto k = (long long) (x / ln2 + (x < 0 ? -0.5 : 0.5));
+            const auto r = x - (double) k * ln2;
+
+            double term = 1, sum = 1;
+            for (int n = 1; n < 20; ++n)
+            {
+                term *= r / n;
+                sum += term;
+            }
+
+            for (long long i = 0; i < k; ++i)
+                sum *= 2;
+            for (long long i = 0; i > k; --i)
+                sum *= 0.5;
+            return sum;
+        }
+
+        constexpr double decibelsToGain(double decibels)
+        {
+            return exp(decibels * ln10 / 20);
+        }
+    }
+
+    //a0 = 1, jak w konstruktorze juce::dsp::IIR::Coefficients
+    constexpr SectionCoefficients normalise(double b0, double b1, double b2, double a0, double a1, double a2)
+    {
+        const auto inverse = 1 / a0;
+        return { b0 * inverse, b1 * inverse, b2 * inverse, a1 * inverse, a2 * inverse };
+    }
+
+    constexpr SectionCoefficients makeFirstOrderLowPass(double sampleRate, double frequency)
+    {
+        const auto n = Math::tan(Math::pi * frequency / sampleRate);
+        return normalise(n, n, 0, n + 1, n - 1, 0);
+    }
+
+    constexpr SectionCoefficients makeFirstOrderHighPass(double sampleRate, double frequency)
+    {
+        const auto n = Math::tan(Math::pi * frequency / sampleRate);
+        return normalise(1, -1, 0, n + 1, n - 1, 0);
+    }
+
+    constexpr SectionCoefficients makeLowPass(double sampleRate, double frequency, double quality)
+    {
+        const auto n = 1 / Math::tan(Math::pi * frequency / sampleRate);
+        const auto nSquared = n * n;
+        const auto invQ = 1 / quality;
+        const auto c1 = 1 / (1 + invQ * n + nSquared);
+        return normalise(c1, c1 * 2, c1, 1, c1 * 2 * (1 - nSquared), c1 * (1 - invQ * n + nSquared));
+    }
+
+    constexpr SectionCoefficients makeHighPass(double sampleRate, double frequency, double quality)
+    {
+        const auto n = Math::tan(Math::pi * frequency / sampleRate);
+        const auto nSquared = n * n;
+        const auto invQ = 1 / quality;
+        const auto c1 = 1 / (1 + invQ * n + nSquared);
+        return normalise(c1, c1 * -2, c1, 1, c1 * 2 * (nSquared - 1), c1 * (1 - invQ * n + nSquared));
+    }
+
+    constexpr SectionCoefficients makePeakFilter(double sampleRate, double frequency, double quality, double gainFactor)
+    {
+        const auto A = Math::sqrt(gainFactor);
+        const auto omega = 2 * Math::pi * (frequency > 2 ? frequency : 2) / sampleRate;
+        const auto alpha = Math::sin(omega) / (quality * 2);
+        const auto c2 = -2 * Math::cos(omega);
+        const auto alphaTimesA = alpha * A;
+        const auto alphaOverA = alpha / A;
+        return normalise(1 + alphaTimesA, c2, 1 - alphaTimesA, 1 + alphaOverA, c2, 1 - alphaOverA);
+    }
+
+    constexpr SectionCoefficients makeLowShelf(double sampleRate, double frequency, double quality, double gainFactor)
+    {
+        const auto A = Math::sqrt(gainFactor);
+        const auto aminus1 = A - 1, aplus1 = A + 1;
+        const auto omega = 2 * Math::pi * (frequency > 2 ? frequency : 2) / sampleRate;
+        const auto coso = Math::cos(omega);
+        const auto beta = Math::sin(omega) * Math::sqrt(A) / quality;
+        const auto aminus1TimesCoso = aminus1 * coso;
+        return normalise(A * (aplus1 - aminus1TimesCoso + beta),
+                         A * 2 * (aminus1 - aplus1 * coso),
+                         A * (aplus1 - aminus1TimesCoso - beta),
+                         aplus1 + aminus1TimesCoso + beta,
+                         -2 * (aminus1 + aplus1 * coso),
+                         aplus1 + aminus1TimesCoso - beta);
+    }
+
+    constexpr SectionCoefficients makeHighShelf(double sampleRate, double frequency, double quality, double gainFactor)
+    {
+        const auto A = Math::sqrt(gainFactor);
+        const auto aminus1 = A - 1, aplus1 = A + 1;
+        const auto omega = 2 * Math::pi * (frequency > 2 ? frequency : 2) / sampleRate;
+        const auto coso = Math::cos(omega);
+        const auto beta = Math::sin(omega) * Math::sqrt(A) / quality;
+        const auto aminus1TimesCoso = aminus1 * coso;
+        return normalise(A * (aplus1 + aminus1TimesCoso + beta),
+                         A * -2 * (aminus1 + aplus1 * coso),
+                         A * (aplus1 + aminus1TimesCoso - beta),
+                         aplus1 - aminus1TimesCoso + beta,
+                         2 * (aminus1 - aplus1 * coso),
+                         aplus1 - aminus1TimesCoso - beta);
+    }
+
+    //Butterworth rzdu order (2-8): dla rzdu nieparzystego sekcja pierwszego rzdu + biquady
+    template<bool isHighPass>
+    constexpr DesignedSections makeButterworth(double frequency, double sampleRate, int order)
+    {
+        DesignedSections result;
+
+        if (order % 2 == 1)
+        {
+            result.sections[0] = isHighPass ? makeFirstOrderHighPass(sampleRate, frequency)
+                                            : makeFirstOrderLowPass(sampleRate, frequency);
+            result.numSections = 1;
+
+            for (int i = 1; i < order / 2 + 1; ++i)
+            {
+                const auto quality = 1.0 / (2.0 * Math::cos(i * Math::pi / order));
+                result.sections[(size_t) result.numSections++] = isHighPass ? makeHighPass(sampleRate, frequency, quality)
+                                                                            : makeLowPass(sampleRate, frequency, quality);
+            }
+        }
+        else
+        {
+            for (int i = 1; i < order / 2 + 1; ++i)
+            {
+                const auto quality = 1.0 / (2.0 * Math::cos((2.0 * i - 1.0) * Math::pi / (order * 2.0)));
+                result.sections[(size_t) result.numSections++] = isHighPass ? makeHighPass(sampleRate, frequency, quality)
+                                                                            : makeLowPass(sampleRate, frequency, quality);
+            }
+        }
+
+        return result;
+    }
+
+    constexpr DesignedSections designButterworthHighPass(double frequency, double sampleRate, int order)
+    {
+        return makeButterworth<true>(frequency, sampleRate, order);
+    }
+
+    constexpr DesignedSections designButterworthLowPass(double frequency, double sampleRate, int order)
+    {
+        return makeButterworth<false>(frequency, sampleRate, order);
+    }
+
+    //sprawdzenie w czasie kompilacji: 0 dB to filtr przezroczysty, LP ma wzmocnienie 1 dla DC
+    static_assert(Math::abs(makePeakFilter(48000.0, 1000.0, 1.0, 1.0).b0 - 1.0) < 1.0e-12, "");
+    static_assert(Math::abs(makePeakFilter(48000.0, 1000.0, 1.0, 1.0).a1 - makePeakFilter(48000.0, 1000.0, 1.0, 1.0).b1) < 1.0e-12, "");
+    static_assert(designButterworthLowPass(1000.0, 48000.0, 8).numSections == 4, "");
+}